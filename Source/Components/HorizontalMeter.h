@@ -29,7 +29,14 @@ namespace Gui
                 juce::jmap(level, -60.f, +6.f, 0.f, static_cast<float>(getWidth()));
             g.fillRoundedRectangle(bounds.removeFromLeft(scaledX), 5.f);
         }
-        void setLevel(const float value) { level = value; }
+        void setLevel(const float value)
+        {
+            if (value != level)
+            {
+                level = value;
+                repaint();
+            }
+        }
     private:
         float level = -60.f;
     };
@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    ResponseCurve.h
+    Created: 19 Oct 2026 9:26:40am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <complex>
+
+namespace Gui
+{
+    // Magnitude response of the wah's state variable filter, computed
+    // analytically from the cutoff the processor publishes. Transparent, so
+    // it can sit on top of the spectrum display.
+    class ResponseCurve : public juce::Component
+    {
+    public:
+        static constexpr int numPoints = 128;
+
+        ResponseCurve()
+        {
+            setInterceptsMouseClicks(false, false);
+            path.preallocateSpace(numPoints * 3 + 8);
+        }
+
+        void paint(juce::Graphics& g) override
+        {
+            if (sampleRate <= 0.0)
+                return;
+
+            // F and q as in the processor's SVF
+            const float F = 2 * sin(juce::MathConstants<float>::pi * cutoff / (float) sampleRate);
+            const double minFreq = 20.0, maxFreq = sampleRate / 2;
+
+            path.clear();
+
+            for (int i = 0; i < numPoints; i++)
+            {
+                const double freq = minFreq * pow(maxFreq / minFreq, (double) i / (numPoints - 1));
+                const float magnitude = getMagnitude(F, (float) (juce::MathConstants<double>::twoPi * freq / sampleRate));
+
+                const auto x = (float) getWidth() * i / (numPoints - 1);
+                const auto y = juce::jmap(juce::jlimit(minDecibels, maxDecibels, juce::Decibels::gainToDecibels(magnitude, minDecibels)),
+                                          minDecibels, maxDecibels, (float) getHeight(), 0.f);
+
+                if (i == 0)
+                    path.startNewSubPath(x, y);
+                else
+                    path.lineTo(x, y);
+            }
+
+            g.setColour(juce::Colours::yellow);
+            g.strokePath(path, juce::PathStrokeType(2.f));
+        }
+
+        // Repaints only when something changed
+        void setParameters(float newCutoff, float newQ, int newFilter, double newSampleRate)
+        {
+            if (newCutoff != cutoff || newQ != q || newFilter != filter || newSampleRate != sampleRate)
+            {
+                cutoff = newCutoff;
+                q = newQ;
+                filter = newFilter;
+                sampleRate = newSampleRate;
+                repaint();
+            }
+        }
+
+    private:
+        static constexpr float minDecibels = -48.0f;
+        static constexpr float maxDecibels = 24.0f;
+
+        // Chamberlin SVF: with A = 1 - z^-1 and D = A^2 + q F z^-1 A + F^2 z^-1,
+        // HP = A^2 / D, BP = F A / D, LP = F^2 / D
+        float getMagnitude(float F, float omega) const
+        {
+            const std::complex<float> d = std::polar(1.0f, -omega);
+            const std::complex<float> A = 1.0f - d;
+            const std::complex<float> D = A * A + q * F * d * A + F * F * d;
+
+            const std::complex<float> numerators[] = { F * F, F * A, A * A };
+            return std::abs(numerators[juce::jlimit(0, 2, filter)] / D);
+        }
+
+        float cutoff = 0.0f, q = 0.1f;
+        int filter = 0;
+        double sampleRate = 0.0;
+        juce::Path path;
+    };
+}
@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    ShapeDrawer.h
+    Created: 19 Oct 2026 9:20:22am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace Gui
+{
+    class ShapeDrawer : public juce::Component
+    {
+    public:
+        static constexpr int numPoints = 32;
+
+        ShapeDrawer(std::function<void(const float*, int)>&& shapeFunction) : shapeConsumer(std::move(shapeFunction))
+        {
+            setOpaque(true);
+
+            for (int i = 0; i < numPoints; i++)
+                points[i] = std::sin(juce::MathConstants<float>::twoPi * i / numPoints);
+        }
+
+        void paint(juce::Graphics& g) override
+        {
+            auto bounds = getLocalBounds().toFloat();
+
+            g.setColour(juce::Colours::black);
+            g.fillRect(bounds);
+
+            juce::Path shape;
+
+            for (int i = 0; i <= numPoints; i++)
+            {
+                const auto x = bounds.getWidth() * i / numPoints;
+                const auto y = juce::jmap(points[i % numPoints], 1.f, -1.f, 0.f, bounds.getHeight());
+
+                if (i == 0)
+                    shape.startNewSubPath(x, y);
+                else
+                    shape.lineTo(x, y);
+            }
+
+            g.setColour(juce::Colours::red);
+            g.strokePath(shape, juce::PathStrokeType(2.f));
+        }
+
+        void mouseDown(const juce::MouseEvent& e) override
+        {
+            mouseDrag(e);
+        }
+
+        void mouseDrag(const juce::MouseEvent& e) override
+        {
+            const auto index = juce::jlimit(0, numPoints - 1, e.x * numPoints / juce::jmax(1, getWidth()));
+            points[index] = juce::jlimit(-1.f, 1.f, juce::jmap((float) e.y, 0.f, (float) getHeight(), 1.f, -1.f));
+
+            shapeConsumer(points, numPoints);
+            repaint();
+        }
+
+        // Shows points set elsewhere, without passing them back to the consumer
+        void setPoints(const float* newPoints, int num)
+        {
+            std::copy(newPoints, newPoints + juce::jmin(num, numPoints), points);
+            repaint();
+        }
+
+    private:
+        std::function<void(const float*, int)> shapeConsumer;
+        float points[numPoints];
+    };
+}
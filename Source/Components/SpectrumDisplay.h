@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    SpectrumDisplay.h
+    Created: 19 Oct 2026 9:26:07am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../DSP/SpectrumAnalyser.h"
+
+namespace Gui
+{
+    class SpectrumDisplay : public juce::Component
+    {
+    public:
+        static constexpr int numBands = Dsp::SpectrumAnalyser::numBands;
+
+        SpectrumDisplay()
+        {
+            setOpaque(true);
+
+            for (auto& stream : bands)
+                juce::FloatVectorOperations::fill(stream, Dsp::SpectrumAnalyser::minDecibels, numBands);
+        }
+
+        void paint(juce::Graphics& g) override
+        {
+            g.fillAll(juce::Colours::black);
+
+            const juce::Colour colours[] = { juce::Colours::grey, juce::Colours::red };
+
+            for (int stream = 0; stream < Dsp::SpectrumAnalyser::numStreams; stream++)
+            {
+                path.clear();
+
+                for (int b = 0; b < numBands; b++)
+                {
+                    const auto x = (float) getWidth() * b / (numBands - 1);
+                    const auto y = juce::jmap(bands[stream][b], Dsp::SpectrumAnalyser::minDecibels, 0.f, (float) getHeight(), 0.f);
+
+                    if (b == 0)
+                        path.startNewSubPath(x, y);
+                    else
+                        path.lineTo(x, y);
+                }
+
+                g.setColour(colours[stream]);
+                g.strokePath(path, juce::PathStrokeType(1.5f));
+            }
+        }
+
+        void setBands(int stream, const float* newBands)
+        {
+            juce::FloatVectorOperations::copy(bands[stream], newBands, numBands);
+            repaint();
+        }
+
+    private:
+        float bands[Dsp::SpectrumAnalyser::numStreams][numBands];
+        juce::Path path;
+    };
+}
@@ -14,26 +14,22 @@
 
 namespace Gui
 {
-    class VerticalGradientMeter : public juce::Component, public juce::Timer
+    class VerticalGradientMeter : public juce::Component
     {
     public:
-        VerticalGradientMeter(std::function<float()>&& valueFunction) : valueSupplier(std::move(valueFunction))
+        VerticalGradientMeter()
         {
-            startTimerHz(24);
+            setOpaque(true);
         }
 
         void paint(juce::Graphics& g) override
         {
-            const auto level = valueSupplier();
-
             auto bounds = getLocalBounds().toFloat();
 
             g.setColour(juce::Colours::black);
             g.fillRect(bounds);
 
             g.setGradientFill(gradient);
-            const auto scaledY =
-                juce::jmap(level, -60.f, 6.f, 0.f, static_cast<float>(getHeight()));
             g.fillRect(bounds.removeFromBottom(scaledY));
         }
 
@@ -48,17 +44,27 @@ namespace Gui
                         false
             };
             gradient.addColour(0.5, juce::Colours::yellow);
+
+            scaledY = juce::roundToInt(juce::jmap(level, -60.f, 6.f, 0.f, static_cast<float>(getHeight())));
         }
 
-        void timerCallback() override
+        // Repaints only when the bar moves by at least a pixel
+        void setLevel(const float value)
         {
-            repaint();
-        }
+            level = value;
 
+            const auto newScaledY = juce::roundToInt(juce::jmap(level, -60.f, 6.f, 0.f, static_cast<float>(getHeight())));
+
+            if (newScaledY != scaledY)
+            {
+                scaledY = newScaledY;
+                repaint();
+            }
+        }
 
     private:
-        std::function<float()> valueSupplier;
+        float level = -60.f;
+        int scaledY = 0;
         juce::ColourGradient gradient{};
     };
 }
-
@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    Crossover.h
+    Created: 19 Oct 2026 9:41:44am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace Dsp
+{
+    // Fourth order Linkwitz-Riley crossover for one channel: a shared
+    // Butterworth section, then a second one per band, all trapezoidal state
+    // variable filters. The bands are in phase and sum to an allpass of the
+    // input. Per sample, so it can sit inside another filter's loop.
+    class Crossover
+    {
+    public:
+        struct Coefficients
+        {
+            float a1 = 1.0f, a2 = 0.0f, a3 = 0.0f;
+
+            static Coefficients make(float frequency, double sampleRate)
+            {
+                const float g = (float) std::tan(juce::MathConstants<double>::pi
+                                                 * juce::jlimit(10.0, 0.49 * sampleRate, (double) frequency) / sampleRate);
+                Coefficients c;
+                c.a1 = 1.0f / (1.0f + g * (g + k));
+                c.a2 = g * c.a1;
+                c.a3 = g * c.a2;
+                return c;
+            }
+        };
+
+        void reset()
+        {
+            for (auto& stage : stages)
+                stage = Stage();
+        }
+
+        // Splits x, returning the low band and writing the high band to high
+        inline float process(float x, float& high, const Coefficients& c)
+        {
+            float lp, hp, unused, low;
+
+            stages[0].process(x, c, lp, hp);
+            stages[1].process(lp, c, low, unused);
+            stages[2].process(hp, c, unused, high);
+
+            return low;
+        }
+
+    private:
+        static constexpr float k = juce::MathConstants<float>::sqrt2; // Butterworth damping
+
+        struct Stage
+        {
+            float ic1 = 0.0f, ic2 = 0.0f;
+
+            inline void process(float x, const Coefficients& c, float& lp, float& hp)
+            {
+                const float v3 = x - ic2;
+                const float v1 = c.a1 * ic1 + c.a2 * v3;
+                const float v2 = ic2 + c.a2 * ic1 + c.a3 * v3;
+
+                ic1 = 2.0f * v1 - ic1;
+                ic2 = 2.0f * v2 - ic2;
+
+                lp = v2;
+                hp = x - k * v1 - v2;
+            }
+        };
+
+        Stage stages[3];
+    };
+}
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    DelayLine.h
+    Created: 19 Oct 2026 9:19:00am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace Dsp
+{
+    // Circular delay, allocated in prepare() and only reallocated there when
+    // it has to grow. A delay change crossfades from the old read position to
+    // the new one over fadeLength samples; a change during a fade waits for
+    // it to finish.
+    class DelayLine
+    {
+    public:
+        static constexpr int fadeLength = 256;
+
+        void prepare(int maxDelaySamples)
+        {
+            int size = 1;
+
+            while (size <= maxDelaySamples)
+                size <<= 1;
+
+            if (size > mask + 1)
+            {
+                data.allocate((size_t) size, true);
+                mask = size - 1;
+            }
+
+            maxDelay = maxDelaySamples;
+            targetDelay = juce::jmin(targetDelay, maxDelay);
+            reset();
+        }
+
+        void reset()
+        {
+            if (data.get() != nullptr)
+                data.clear((size_t) mask + 1);
+
+            writePos = 0;
+            delay = targetDelay;
+            fadeRemaining = 0;
+        }
+
+        void setDelay(int newDelaySamples)
+        {
+            targetDelay = juce::jlimit(0, maxDelay, newDelaySamples);
+        }
+
+        int getDelay() const { return targetDelay; }
+
+        // Delays samples[0..numSamples) in place. The input is always written,
+        // so a longer delay has its history ready.
+        void process(float* samples, int numSamples)
+        {
+            for (int i = 0; i < numSamples; i++)
+            {
+                data[writePos] = samples[i];
+
+                if (fadeRemaining == 0 && delay != targetDelay)
+                {
+                    previousDelay = delay;
+                    delay = targetDelay;
+                    fadeRemaining = fadeLength;
+                }
+
+                float y = data[(writePos - delay) & mask];
+
+                if (fadeRemaining > 0)
+                {
+                    const float old = data[(writePos - previousDelay) & mask];
+                    y += (float) fadeRemaining / fadeLength * (old - y);
+                    --fadeRemaining;
+                }
+
+                samples[i] = y;
+                writePos = (writePos + 1) & mask;
+            }
+        }
+
+    private:
+        juce::HeapBlock<float> data;
+        int mask = 0, writePos = 0, maxDelay = 0;
+        int delay = 0, previousDelay = 0, targetDelay = 0, fadeRemaining = 0;
+    };
+}
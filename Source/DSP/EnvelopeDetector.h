@@ -0,0 +1,162 @@
+/*
+  ==============================================================================
+
+    EnvelopeDetector.h
+    Created: 19 Oct 2026 9:18:22am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Kernels.h"
+
+namespace Dsp
+{
+    // Level detector for the dynamic mode. Each type works on whole blocks:
+    // the rectification stage is vectorised, the ballistics stage is the only
+    // per-sample recursion. The envelope comes out in the sample type.
+    template <typename SampleType>
+    class BasicEnvelopeDetector
+    {
+    public:
+        using Ballistics = BallisticsKernel<SampleType>;
+
+        enum Type
+        {
+            peak = 0,
+            rms,
+            logarithmic
+        };
+
+        void prepare(double newSampleRate)
+        {
+            sampleRate = newSampleRate;
+
+            windowLength = juce::jmax(1, juce::roundToInt(rmsWindowSeconds * sampleRate));
+            window.allocate((size_t) windowLength, true);
+
+            attackSeconds = releaseSeconds = -1.0f;
+            reset();
+        }
+
+        void reset()
+        {
+            if (window.get() != nullptr)
+                window.clear((size_t) windowLength);
+
+            windowPos = 0;
+            windowSum = 0.0;
+            state = {};
+        }
+
+        void setType(int newType)
+        {
+            if (newType != type)
+            {
+                type = newType;
+                reset();
+            }
+        }
+
+        void setAttackRelease(float newAttackSeconds, float newReleaseSeconds)
+        {
+            if (newAttackSeconds != attackSeconds)
+            {
+                attackSeconds = newAttackSeconds;
+                attackCoeff = exp(-1.0f / (attackSeconds * (float) sampleRate));
+            }
+
+            if (newReleaseSeconds != releaseSeconds)
+            {
+                releaseSeconds = newReleaseSeconds;
+                releaseCoeff = exp(-1.0f / (releaseSeconds * (float) sampleRate));
+            }
+        }
+
+        // Writes the envelope of in[0..numSamples) to out, which may alias in
+        // when both are float.
+        void process(const float* in, SampleType* out, int numSamples)
+        {
+            // the float level of the other types needs scratch: on the stack
+            for (int start = 0; start < numSamples; start += chunkSize)
+            {
+                const int chunk = juce::jmin(chunkSize, numSamples - start);
+                float scratch[chunkSize];
+
+                processChunk(in + start, Ballistics::getLevelBuffer(out + start, scratch), out + start, chunk);
+            }
+        }
+
+    private:
+        static constexpr int chunkSize = 256;
+
+        void processChunk(const float* in, float* level, SampleType* out, int numSamples)
+        {
+            if (type == rms)
+            {
+                juce::FloatVectorOperations::multiply(level, in, in, numSamples);
+
+                const float invLength = 1.0f / (float) windowLength;
+
+                for (int i = 0; i < numSamples; i++)
+                {
+                    windowSum += level[i] - window[windowPos];
+                    window[windowPos] = level[i];
+
+                    if (++windowPos == windowLength)
+                        windowPos = 0;
+
+                    level[i] = sqrt(juce::jmax(0.0f, (float) windowSum * invLength));
+                }
+
+                applyBallistics(level, out, numSamples);
+            }
+            else if (type == logarithmic)
+            {
+                juce::FloatVectorOperations::abs(level, in, numSamples);
+                juce::FloatVectorOperations::max(level, level, floorGain, numSamples);
+
+                for (int i = 0; i < numSamples; i++)
+                    level[i] = log(level[i]);
+
+                // -60..0 dB mapped onto 0..1; the map is linear, so doing it
+                // before the smoothing keeps the state in 0..1 for every type
+                juce::FloatVectorOperations::multiply(level, -1.0f / logFloor, numSamples);
+                juce::FloatVectorOperations::add(level, 1.0f, numSamples);
+
+                applyBallistics(level, out, numSamples);
+
+                Ballistics::limit(out, numSamples);
+            }
+            else
+            {
+                juce::FloatVectorOperations::abs(level, in, numSamples);
+                applyBallistics(level, out, numSamples);
+            }
+        }
+
+        void applyBallistics(const float* level, SampleType* out, int numSamples)
+        {
+            Ballistics::process(state, level, out, numSamples, attackCoeff, releaseCoeff);
+        }
+
+        static constexpr float rmsWindowSeconds = 0.01f;
+        static constexpr float floorGain = 0.001f;   // -60 dB
+        static constexpr float logFloor = -6.9077553f; // ln(0.001)
+
+        double sampleRate = 44100.0;
+        int type = peak;
+
+        float attackSeconds = -1.0f, releaseSeconds = -1.0f;
+        float attackCoeff = 0.0f, releaseCoeff = 0.0f;
+        typename Ballistics::State state {};
+
+        juce::HeapBlock<float> window;
+        int windowLength = 1, windowPos = 0;
+        double windowSum = 0.0;
+    };
+
+    using EnvelopeDetector = BasicEnvelopeDetector<EngineSample>;
+}
@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    FixedPoint.h
+    Created: 19 Oct 2026 9:45:25am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Builds the filter, envelope and LFO kernels in Q31 fixed point, for
+// targets without a fast FPU, when the project defines WAH_FIXED_POINT=1.
+#ifndef WAH_FIXED_POINT
+ #define WAH_FIXED_POINT 0
+#endif
+
+namespace Dsp
+{
+    // Q31 signals and state (-1..1 in an int32), Q15 coefficients (int16)
+    // where that resolution is enough, 64 bit intermediates, saturating
+    // wherever a result can overflow.
+    namespace Fixed
+    {
+        using Q31 = juce::int32;
+        using Q15 = juce::int16;
+
+        inline Q31 saturate(juce::int64 x)
+        {
+            return (Q31) juce::jlimit((juce::int64) std::numeric_limits<Q31>::min(),
+                                      (juce::int64) std::numeric_limits<Q31>::max(), x);
+        }
+
+        inline Q31 toQ31(float x)
+        {
+            return saturate((juce::int64) std::lrint((double) x * 2147483648.0));
+        }
+
+        inline float fromQ31(Q31 x)
+        {
+            return (float) x * (1.0f / 2147483648.0f);
+        }
+
+        inline Q15 toQ15(float x)
+        {
+            return (Q15) juce::jlimit(-32768L, 32767L, std::lrint(x * 32768.0f));
+        }
+
+        inline Q31 add(Q31 a, Q31 b)
+        {
+            return saturate((juce::int64) a + b);
+        }
+
+        inline Q31 sub(Q31 a, Q31 b)
+        {
+            return saturate((juce::int64) a - b);
+        }
+
+        // Q31 * Q15, rounded
+        inline Q31 mul(Q31 a, Q15 b)
+        {
+            return saturate(((juce::int64) a * b + (1 << 14)) >> 15);
+        }
+
+        // Q31 * Q31, rounded
+        inline Q31 mul(Q31 a, Q31 b)
+        {
+            return saturate(((juce::int64) a * b + (1LL << 30)) >> 31);
+        }
+
+        // Block conversions at the edges of the fixed point path: a scale,
+        // clamp and truncating cast the compiler can vectorise, where toQ31
+        // rounds through lrint one sample at a time.
+        inline Q31 scaleToQ31(float x)
+        {
+            // 2147483520 is the largest float below 2^31
+            return (Q31) juce::jlimit(-2147483648.0f, 2147483520.0f, x * 2147483648.0f);
+        }
+
+        inline void toQ31(const float* src, Q31* dest, float gain, int numSamples)
+        {
+            for (int i = 0; i < numSamples; i++)
+                dest[i] = scaleToQ31(src[i] * gain);
+        }
+
+        inline void addFromQ31(float* dest, const Q31* src, float gain, int numSamples)
+        {
+            const float scale = gain * (1.0f / 2147483648.0f);
+
+            for (int i = 0; i < numSamples; i++)
+                dest[i] += (float) src[i] * scale;
+        }
+    }
+
+    // The sample type the kernels are instantiated with
+   #if WAH_FIXED_POINT
+    using EngineSample = Fixed::Q31;
+   #else
+    using EngineSample = float;
+   #endif
+}
@@ -0,0 +1,165 @@
+/*
+  ==============================================================================
+
+    FormantBank.h
+    Created: 19 Oct 2026 9:22:24am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace Dsp
+{
+    struct Formant
+    {
+        float freq, bandwidth, gainDb;
+    };
+
+    // Humanizer filter: one state variable filter per formant, the formants
+    // packed into SIMD lanes so the whole bank steps in a few vector ops.
+    class FormantBank
+    {
+    public:
+        using Vec = juce::dsp::SIMDRegister<float>;
+
+        static constexpr int numVowels = 5;
+        static constexpr int numFormants = 4;
+        static constexpr int numLanes = (int) Vec::SIMDNumElements;
+        static constexpr int numRegisters = (numFormants + numLanes - 1) / numLanes;
+
+        // A E I O U
+        static const Formant& getFormant(int vowel, int formant)
+        {
+            static const Formant formants[numVowels][numFormants] =
+            {
+                { { 1000.0f, 80.0f,  0.0f }, { 1400.0f, 90.0f,  -6.0f }, { 2650.0f, 120.0f,  -7.0f }, { 2900.0f, 130.0f,  -8.0f } },
+                { {  500.0f, 70.0f,  0.0f }, { 2300.0f, 80.0f, -14.0f }, { 2600.0f, 100.0f, -12.0f }, { 3200.0f, 120.0f, -14.0f } },
+                { {  320.0f, 40.0f,  0.0f }, { 2500.0f, 90.0f, -15.0f }, { 2800.0f, 100.0f, -18.0f }, { 3250.0f, 120.0f, -20.0f } },
+                { {  500.0f, 40.0f,  0.0f }, { 1000.0f, 80.0f, -10.0f }, { 2600.0f, 100.0f, -12.0f }, { 2800.0f, 120.0f, -12.0f } },
+                { {  320.0f, 40.0f,  0.0f }, {  800.0f, 60.0f, -20.0f }, { 2700.0f, 100.0f, -17.0f }, { 2900.0f, 120.0f, -14.0f } }
+            };
+
+            return formants[vowel][formant];
+        }
+
+        // SVF damping of a formant at a quality, shared with the tail length
+        static float getDamping(float freq, float bandwidth, float quality)
+        {
+            return juce::jlimit(0.01f, 2.0f, bandwidth / freq * quality * 10.0f);
+        }
+
+        // Coefficients of every formant, lane k holding formant k.
+        // Unused lanes have zero gain.
+        struct Coefficients
+        {
+            Vec F[numRegisters], q[numRegisters], g[numRegisters];
+
+            // The formants a given position of the way from one vowel to the other.
+            // Quality 0.1 (the default) gives the nominal formant bandwidths.
+            void setMorph(int firstVowel, int secondVowel, float position, float quality, double sampleRate)
+            {
+                float Fs[numRegisters * numLanes] = {};
+                float qs[numRegisters * numLanes] = {};
+                float gs[numRegisters * numLanes] = {};
+                float firstGainSum = 0.0f, secondGainSum = 0.0f;
+
+                for (int k = 0; k < numFormants; k++)
+                {
+                    firstGainSum += juce::Decibels::decibelsToGain(getFormant(firstVowel, k).gainDb);
+                    secondGainSum += juce::Decibels::decibelsToGain(getFormant(secondVowel, k).gainDb);
+                }
+
+                for (int k = 0; k < numFormants; k++)
+                {
+                    const Formant& a = getFormant(firstVowel, k);
+                    const Formant& b = getFormant(secondVowel, k);
+
+                    const float freq = a.freq + (b.freq - a.freq) * position;
+                    const float bandwidth = a.bandwidth + (b.bandwidth - a.bandwidth) * position;
+
+                    Fs[k] = 2 * sin(juce::MathConstants<float>::pi * freq / (float) sampleRate);
+                    qs[k] = getDamping(freq, bandwidth, quality);
+                    gs[k] = (1.0f - position) * juce::Decibels::decibelsToGain(a.gainDb) / firstGainSum
+                          + position * juce::Decibels::decibelsToGain(b.gainDb) / secondGainSum;
+                }
+
+                for (int r = 0; r < numRegisters; r++)
+                {
+                    for (int lane = 0; lane < numLanes; lane++)
+                    {
+                        F[r].set((size_t) lane, Fs[r * numLanes + lane]);
+                        q[r].set((size_t) lane, qs[r * numLanes + lane]);
+                        g[r].set((size_t) lane, gs[r * numLanes + lane]);
+                    }
+                }
+            }
+        };
+
+        // One segment of a morph: coefficients = from + delta * frac
+        struct Morph
+        {
+            Coefficients from, delta;
+
+            void set(const Coefficients& start, const Coefficients& end)
+            {
+                from = start;
+
+                for (int r = 0; r < numRegisters; r++)
+                {
+                    delta.F[r] = end.F[r] - start.F[r];
+                    delta.q[r] = end.q[r] - start.q[r];
+                    delta.g[r] = end.g[r] - start.g[r];
+                }
+            }
+        };
+
+        void reset()
+        {
+            for (int r = 0; r < numRegisters; r++)
+                yh[r] = yb[r] = yl[r] = Vec::expand(0.0f);
+        }
+
+        // One sample through the bank; output 0, 1, 2 selects the lowpass,
+        // bandpass or highpass outputs, weighted by the formant gains.
+        float process(float x, const Morph& morph, float frac, int output)
+        {
+            const Vec in = Vec::expand(x);
+            const Vec p = Vec::expand(frac);
+            const Vec* y = (output == 0) ? yl : (output == 1) ? yb : yh;
+            Vec sum = Vec::expand(0.0f);
+
+            for (int r = 0; r < numRegisters; r++)
+            {
+                const Vec F = morph.from.F[r] + morph.delta.F[r] * p;
+                const Vec q = morph.from.q[r] + morph.delta.q[r] * p;
+                const Vec g = morph.from.g[r] + morph.delta.g[r] * p;
+
+                yh[r] = in - yl[r] - q * yb[r];
+                yb[r] = F * yh[r] + yb[r];
+                yl[r] = F * yb[r] + yl[r];
+
+                sum += g * y[r];
+            }
+
+            return sum.sum();
+        }
+
+        // Largest state magnitude, for telling when the bank has rung out
+        float getStateMagnitude() const
+        {
+            float magnitude = 0.0f;
+
+            for (int r = 0; r < numRegisters; r++)
+                for (size_t lane = 0; lane < (size_t) numLanes; lane++)
+                    magnitude = juce::jmax(magnitude, std::abs(yh[r].get(lane)), std::abs(yb[r].get(lane)), std::abs(yl[r].get(lane)));
+
+            return magnitude;
+        }
+
+    private:
+        Vec yh[numRegisters], yb[numRegisters], yl[numRegisters];
+    };
+}
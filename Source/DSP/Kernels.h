@@ -0,0 +1,395 @@
+/*
+  ==============================================================================
+
+    Kernels.h
+    Created: 19 Oct 2026 9:45:25am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "FixedPoint.h"
+
+namespace Dsp
+{
+    // The per-sample recursions of the wah, specialised per sample type. The
+    // float versions are the reference. The Q31 versions keep signals, sweep
+    // positions and state in fixed point, read coefficients from tables
+    // quantised when they are built, and meet float only in block conversions
+    // at the engine's input and output.
+
+    //==============================================================================
+    // Sweep position to SVF coefficient through a table of 2^tableBits entries
+    // (plus a guard point), linearly interpolated. Positions are 0..1, the
+    // LFO's -1..1 is mapped onto that first.
+    template <typename SampleType>
+    struct SweepKernel;
+
+    template <>
+    struct SweepKernel<float>
+    {
+        using Coefficient = float;
+
+        static Coefficient makeCoefficient(float F)
+        {
+            return F;
+        }
+
+        static float coefficientToFloat(Coefficient F)
+        {
+            return F;
+        }
+
+        static float positionToFloat(float position)
+        {
+            return position;
+        }
+
+        static float fromBipolar(float x)
+        {
+            return 0.5f + 0.5f * x;
+        }
+
+        template <int tableBits>
+        static Coefficient lookup(const Coefficient* table, float position)
+        {
+            constexpr int tableSize = 1 << tableBits;
+
+            const float pos = juce::jlimit(0.0f, 1.0f, position) * tableSize;
+            const int index = juce::jmin((int) pos, tableSize - 1);
+
+            return table[index] + (pos - index) * (table[index + 1] - table[index]);
+        }
+    };
+
+    template <>
+    struct SweepKernel<Fixed::Q31>
+    {
+        // F reaches about 1.4 at the top of the sweep, past 1: the tables hold
+        // F / 2 and the filter doubles the product back. At Q31, like the
+        // ballistics step: low in the sweep a Q15 F detunes the resonance
+        // audibly against the float filter.
+        using Coefficient = Fixed::Q31;
+
+        static Coefficient makeCoefficient(float F)
+        {
+            return Fixed::toQ31(0.5f * F);
+        }
+
+        static float coefficientToFloat(Coefficient halfF)
+        {
+            return 2.0f * Fixed::fromQ31(halfF);
+        }
+
+        static float positionToFloat(Fixed::Q31 position)
+        {
+            return Fixed::fromQ31(position);
+        }
+
+        static Fixed::Q31 fromBipolar(Fixed::Q31 x)
+        {
+            return (x >> 1) + (1 << 30);
+        }
+
+        // The top bits of the position index the table, the rest interpolate
+        template <int tableBits>
+        static Coefficient lookup(const Coefficient* table, Fixed::Q31 position)
+        {
+            constexpr int indexShift = 31 - tableBits;
+
+            const juce::uint32 p = (juce::uint32) juce::jmax(0, position);
+            const int index = (int) (p >> indexShift);
+            const juce::int64 frac = p & ((1u << indexShift) - 1);
+            const juce::int64 a = table[index];
+            const juce::int64 b = table[index + 1];
+
+            return (Coefficient) (a + (((b - a) * frac) >> indexShift));
+        }
+    };
+
+    //==============================================================================
+    // Chamberlin state variable filter, one sample
+    template <typename SampleType>
+    struct SvfKernel;
+
+    template <>
+    struct SvfKernel<float>
+    {
+        using Coefficient = SweepKernel<float>::Coefficient;
+        using Damping = float;
+
+        struct State
+        {
+            float hp = 0.0f, bp = 0.0f, lp = 0.0f;
+
+            float getMagnitude() const
+            {
+                return juce::jmax(std::abs(hp), std::abs(bp), std::abs(lp));
+            }
+        };
+
+        static Damping makeDamping(float Q)
+        {
+            return Q;
+        }
+
+        // The float filter runs on the buffers it is given
+        static float toSample(float x)
+        {
+            return x;
+        }
+
+        static const float* toSamples(const float* in, float*, int)
+        {
+            return in;
+        }
+
+        static void addToOutput(float* out, const float* wet, float gain, int numSamples)
+        {
+            juce::FloatVectorOperations::addWithMultiply(out, wet, gain, numSamples);
+        }
+
+        static inline float process(State& s, float x, Coefficient F, Damping Q, int filter)
+        {
+            s.hp = x - s.lp - Q * s.bp;
+            s.bp = F * s.hp + s.bp;
+            s.lp = F * s.bp + s.lp;
+
+            const float y[] = { s.lp, s.bp, s.hp };
+            return y[filter];
+        }
+    };
+
+    template <>
+    struct SvfKernel<Fixed::Q31>
+    {
+        using Coefficient = SweepKernel<Fixed::Q31>::Coefficient;
+        using Damping = Fixed::Q15;
+
+        // resonance gain on top of a full scale input needs room: 24 dB, past
+        // that (very low damping) the state saturates like a clipping stage
+        static constexpr float headroom = 1.0f / 16.0f;
+
+        struct State
+        {
+            Fixed::Q31 hp = 0, bp = 0, lp = 0;
+
+            float getMagnitude() const
+            {
+                return juce::jmax(std::abs(Fixed::fromQ31(hp)), std::abs(Fixed::fromQ31(bp)), std::abs(Fixed::fromQ31(lp))) / headroom;
+            }
+        };
+
+        static Damping makeDamping(float Q)
+        {
+            return Fixed::toQ15(Q);
+        }
+
+        // In and out of fixed point at the engine's edges, with the headroom
+        static Fixed::Q31 toSample(float x)
+        {
+            return Fixed::scaleToQ31(x * headroom);
+        }
+
+        static const Fixed::Q31* toSamples(const float* in, Fixed::Q31* dest, int numSamples)
+        {
+            Fixed::toQ31(in, dest, headroom, numSamples);
+            return dest;
+        }
+
+        static void addToOutput(float* out, const Fixed::Q31* wet, float gain, int numSamples)
+        {
+            Fixed::addFromQ31(out, wet, gain / headroom, numSamples);
+        }
+
+        // a * F from F / 2, rounded
+        static inline Fixed::Q31 mulF(Fixed::Q31 a, Coefficient halfF)
+        {
+            return Fixed::saturate(((juce::int64) a * halfF + (1LL << 29)) >> 30);
+        }
+
+        static inline Fixed::Q31 process(State& s, Fixed::Q31 x, Coefficient halfF, Damping Q, int filter)
+        {
+            using namespace Fixed;
+
+            s.hp = sub(sub(x, s.lp), mul(s.bp, Q));
+            s.bp = add(mulF(s.hp, halfF), s.bp);
+            s.lp = add(mulF(s.bp, halfF), s.lp);
+
+            const Q31 y[] = { s.lp, s.bp, s.hp };
+            return y[filter];
+        }
+    };
+
+    //==============================================================================
+    // Attack/release one-pole smoothing of a rectified level. The level is
+    // computed in float for every type (rms and log need it); the kernel says
+    // where to put it and smooths it into the output.
+    template <typename SampleType>
+    struct BallisticsKernel;
+
+    template <>
+    struct BallisticsKernel<float>
+    {
+        using State = float;
+
+        // in place, straight in the output
+        static float* getLevelBuffer(float* out, float*)
+        {
+            return out;
+        }
+
+        static void process(State& state, const float* level, float* out, int numSamples, float attackCoeff, float releaseCoeff)
+        {
+            float y = state;
+
+            for (int i = 0; i < numSamples; i++)
+            {
+                const float alpha = (level[i] > y) ? attackCoeff : releaseCoeff;
+                y = alpha * y + (1.0f - alpha) * level[i];
+                out[i] = y;
+            }
+
+            state = y;
+        }
+
+        static void limit(float* data, int numSamples)
+        {
+            juce::FloatVectorOperations::clip(data, data, 0.0f, 1.0f, numSamples);
+        }
+    };
+
+    template <>
+    struct BallisticsKernel<Fixed::Q31>
+    {
+        using State = Fixed::Q31;
+
+        static float* getLevelBuffer(Fixed::Q31*, float* scratch)
+        {
+            return scratch;
+        }
+
+        // Long release times put 1 - alpha far below Q15 resolution, so the
+        // step size is the one coefficient kept at Q31.
+        static void process(State& state, const float* level, Fixed::Q31* out, int numSamples, float attackCoeff, float releaseCoeff)
+        {
+            using namespace Fixed;
+
+            toQ31(level, out, 1.0f, numSamples);
+
+            const Q31 attackStep = Fixed::toQ31(1.0f - attackCoeff);
+            const Q31 releaseStep = Fixed::toQ31(1.0f - releaseCoeff);
+            Q31 y = state;
+
+            for (int i = 0; i < numSamples; i++)
+            {
+                y = add(y, mul(sub(out[i], y), out[i] > y ? attackStep : releaseStep));
+                out[i] = y;
+            }
+
+            state = y;
+        }
+
+        // the conversion already saturated at full scale
+        static void limit(Fixed::Q31*, int)
+        {
+        }
+    };
+
+    //==============================================================================
+    // Phase accumulator reading a single-cycle table of 2^tableBits entries
+    // (plus a guard point) with linear interpolation; phase is in cycles, 0..1
+    template <typename SampleType>
+    struct LfoKernel;
+
+    template <>
+    struct LfoKernel<float>
+    {
+        using TableValue = float;
+
+        static TableValue makeTableValue(float value)
+        {
+            return value;
+        }
+
+        static float toSample(TableValue value)
+        {
+            return value;
+        }
+
+        template <int tableBits>
+        static void process(const TableValue* table, double& phase, double increment, juce::uint32& cycle, float* out, int numSamples)
+        {
+            constexpr int tableSize = 1 << tableBits;
+
+            for (int i = 0; i < numSamples; i++)
+            {
+                // in double: a phase just under 1 rounds up to tableSize in float
+                const double pos = phase * tableSize;
+                const int index = juce::jmin((int) pos, tableSize - 1);
+                const float frac = (float) (pos - index);
+
+                out[i] = table[index] + frac * (table[index + 1] - table[index]);
+
+                phase += increment;
+
+                if (phase >= 1.0)
+                {
+                    phase -= 1.0;
+                    ++cycle;
+                }
+            }
+        }
+    };
+
+    template <>
+    struct LfoKernel<Fixed::Q31>
+    {
+        // At Q31 like the sweep table it indexes: a Q15 table's steps show
+        // up as sweep jitter, about 15 dB of SNR against the float LFO.
+        using TableValue = Fixed::Q31;
+
+        static TableValue makeTableValue(float value)
+        {
+            return Fixed::toQ31(value);
+        }
+
+        static Fixed::Q31 toSample(TableValue value)
+        {
+            return value;
+        }
+
+        // The phase runs as an unsigned 0.32 fraction, so wrapping is the
+        // integer overflow; the top bits index the table, the rest
+        // interpolate.
+        template <int tableBits>
+        static void process(const TableValue* table, double& phase, double increment, juce::uint32& cycle, Fixed::Q31* out, int numSamples)
+        {
+            constexpr int indexShift = 32 - tableBits;
+
+            juce::uint32 p = (juce::uint32) (juce::int64) (phase * 4294967296.0);
+            const juce::uint32 step = (juce::uint32) (juce::int64) (increment * 4294967296.0);
+
+            for (int i = 0; i < numSamples; i++)
+            {
+                const int index = (int) (p >> indexShift);
+                const juce::int64 frac = p & ((1u << indexShift) - 1);
+                const juce::int64 a = table[index];
+                const juce::int64 b = table[index + 1];
+
+                out[i] = (Fixed::Q31) (a + (((b - a) * frac) >> indexShift));
+
+                const juce::uint32 next = p + step;
+
+                if (next < p)
+                    ++cycle;
+
+                p = next;
+            }
+
+            phase = p / 4294967296.0;
+        }
+    };
+}
@@ -0,0 +1,272 @@
+/*
+  ==============================================================================
+
+    Lfo.h
+    Created: 19 Oct 2026 9:20:22am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Kernels.h"
+
+namespace Dsp
+{
+    // Tempo-mode sweep oscillator: a phase accumulator reading precomputed
+    // single-cycle tables, so every shape costs one interpolated lookup. The
+    // tables and the output are in the sample type.
+    template <typename SampleType>
+    class BasicLfo
+    {
+    public:
+        using Kernel = LfoKernel<SampleType>;
+        using TableValue = typename Kernel::TableValue;
+
+        enum Shape
+        {
+            sine = 0,
+            triangle,
+            sawUp,
+            sawDown,
+            square,
+            sampleAndHold,
+            user,
+            numShapes
+        };
+
+        static constexpr int tableBits = 11;
+        static constexpr int tableSize = 1 << tableBits;
+        static constexpr int numUserPoints = 32;
+
+        BasicLfo()
+        {
+            const TableValue* sineTable = getTables().shapes[sine];
+
+            for (auto& table : userTables)
+            {
+                table.allocate(tableSize + 1, true);
+                std::copy(sineTable, sineTable + tableSize + 1, table.get());
+            }
+        }
+
+        void prepare(double newSampleRate)
+        {
+            sampleRate = newSampleRate;
+            reset();
+        }
+
+        void reset()
+        {
+            phase = 0.0;
+            cycle = 0;
+        }
+
+        void setShape(int newShape)
+        {
+            shape = juce::jlimit(0, numShapes - 1, newShape);
+        }
+
+        void setRate(float newRate)
+        {
+            increment = newRate / sampleRate;
+        }
+
+        // Called from the message thread: fills a user table the audio thread
+        // can't be reading from a cyclic list of points in -1..1, then makes
+        // it the active one.
+        void setUserShape(const float* points, int numPoints)
+        {
+            int next = 0;
+
+            while (next == userActive.load() || next == userInUse.load())
+                next++;
+
+            TableValue* table = userTables[next].get();
+
+            for (int i = 0; i <= tableSize; i++)
+            {
+                const float pos = (float) (i % tableSize) * numPoints / tableSize;
+                const int p0 = (int) pos;
+                const int p1 = (p0 + 1) % numPoints;
+
+                table[i] = Kernel::makeTableValue(points[p0] + (pos - p0) * (points[p1] - points[p0]));
+            }
+
+            userActive.store(next);
+        }
+
+        // Writes the next numSamples values, in -1..1, to out.
+        void process(SampleType* out, int numSamples)
+        {
+            if (shape == sampleAndHold)
+            {
+                const TableValue* values = getTables().randomValues;
+
+                for (int i = 0; i < numSamples; i++)
+                {
+                    out[i] = Kernel::toSample(values[cycle & (numRandomValues - 1)]);
+                    advance();
+                }
+            }
+            else
+            {
+                const TableValue* table = (shape == user) ? acquireUserTable()
+                                                          : getTables().shapes[shape];
+
+                Kernel::template process<tableBits>(table, phase, increment, cycle, out, numSamples);
+            }
+        }
+
+        // One accumulator for several channels, channel c read offsets[c]
+        // cycles ahead, so an offset channel costs a lookup, not an oscillator.
+        void process(SampleType* const* outs, const double* offsets, int numChannels, int numSamples)
+        {
+            const double startPhase = phase;
+            const juce::uint32 startCycle = cycle;
+
+            for (int c = 0; c < numChannels; c++)
+            {
+                phase = startPhase;
+                cycle = startCycle;
+                skipPhase(offsets[c]);
+                process(outs[c], numSamples);
+            }
+
+            phase = startPhase;
+            cycle = startCycle;
+            skip(numSamples);
+        }
+
+        // Jumps to a point in the cycle, wrapped into 0..1
+        void setPhase(double newPhase)
+        {
+            phase = newPhase - std::floor(newPhase);
+        }
+
+        // Advances as if numSamples had been rendered, keeping the sweep in
+        // time while nothing is processed.
+        void skip(int numSamples)
+        {
+            skipPhase(increment * numSamples);
+        }
+
+    private:
+        static constexpr int numRandomValues = 256;
+        static constexpr int numHarmonics = 16;
+
+        // Shared by every instance, built once on first use
+        struct Tables
+        {
+            Tables()
+            {
+                // built in float, then stored in the kernel's table format
+                juce::HeapBlock<float> work((size_t) sampleAndHold * (tableSize + 1));
+                auto at = [&](int s) { return work.get() + (size_t) s * (tableSize + 1); };
+
+                for (int i = 0; i <= tableSize; i++)
+                {
+                    const double t = juce::MathConstants<double>::twoPi * (i % tableSize) / tableSize;
+                    double tri = 0.0, saw = 0.0, sqr = 0.0;
+
+                    // band-limited additive series, sigma-smoothed against Gibbs ringing
+                    for (int n = 1; n <= numHarmonics; n++)
+                    {
+                        const double x = juce::MathConstants<double>::pi * n / (numHarmonics + 1);
+                        const double sigma = sin(x) / x;
+                        const double h = sigma * sin(n * t);
+
+                        saw += h / n;
+
+                        if (n % 2 == 1)
+                        {
+                            tri += ((n / 2) % 2 == 0 ? 1.0 : -1.0) * h / (n * n);
+                            sqr += h / n;
+                        }
+                    }
+
+                    at(sine)[i] = (float) sin(t);
+                    at(triangle)[i] = (float) tri;
+                    at(sawUp)[i] = (float) -saw;
+                    at(sawDown)[i] = (float) saw;
+                    at(square)[i] = (float) sqr;
+                }
+
+                for (int s = triangle; s <= square; s++)
+                {
+                    float peak = 0.0f;
+
+                    for (int i = 0; i <= tableSize; i++)
+                        peak = juce::jmax(peak, std::abs(at(s)[i]));
+
+                    for (int i = 0; i <= tableSize; i++)
+                        at(s)[i] /= peak;
+                }
+
+                for (int s = 0; s < sampleAndHold; s++)
+                    for (int i = 0; i <= tableSize; i++)
+                        shapes[s][i] = Kernel::makeTableValue(at(s)[i]);
+
+                juce::Random random(0x5eed);
+
+                for (auto& value : randomValues)
+                    value = Kernel::makeTableValue(random.nextFloat() * 2.0f - 1.0f);
+            }
+
+            TableValue shapes[sampleAndHold][tableSize + 1];
+            TableValue randomValues[numRandomValues];
+        };
+
+        static const Tables& getTables()
+        {
+            static const Tables tables;
+            return tables;
+        }
+
+        void skipPhase(double cycles)
+        {
+            phase += cycles;
+
+            const double wholeCycles = std::floor(phase);
+            cycle += (juce::uint32) (juce::int64) wholeCycles;
+            phase -= wholeCycles;
+        }
+
+        // Pins the active user table until the next call, as VowelMorphTable does
+        const TableValue* acquireUserTable()
+        {
+            int index;
+
+            do
+            {
+                index = userActive.load();
+                userInUse.store(index);
+            }
+            while (index != userActive.load());
+
+            return userTables[index].get();
+        }
+
+        void advance()
+        {
+            phase += increment;
+
+            if (phase >= 1.0)
+            {
+                phase -= 1.0;
+                ++cycle;
+            }
+        }
+
+        double sampleRate = 44100.0;
+        double phase = 0.0, increment = 0.0;
+        juce::uint32 cycle = 0;
+        int shape = sine;
+
+        juce::HeapBlock<TableValue> userTables[3];
+        std::atomic<int> userActive { 0 }, userInUse { 0 };
+    };
+
+    using Lfo = BasicLfo<EngineSample>;
+}
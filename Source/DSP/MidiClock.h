@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+    MidiClock.h
+    Created: 19 Oct 2026 9:40:16am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace Dsp
+{
+    // Follows incoming MIDI clock (24 ticks per beat) with a second order
+    // phase-locked loop: each tick's timestamp corrects a predicted tick time
+    // and the tick period, so timestamp jitter is smoothed out of both. It is
+    // updated once per clock message, times are in samples.
+    class MidiClock
+    {
+    public:
+        static constexpr int ticksPerBeat = 24;
+
+        void prepare(double newSampleRate)
+        {
+            sampleRate = newSampleRate;
+            reset();
+        }
+
+        void reset()
+        {
+            locked = false;
+            running = false;
+            lastTick = -1;
+            position = -1;
+        }
+
+        // Start: the next tick is the first beat
+        void start()
+        {
+            running = true;
+            position = -1;
+        }
+
+        void resume()
+        {
+            running = true;
+        }
+
+        void stop()
+        {
+            running = false;
+        }
+
+        // Song position pointer, in sixteenth notes
+        void setSongPosition(int sixteenths)
+        {
+            position = (juce::int64) sixteenths * (ticksPerBeat / 4) - 1;
+        }
+
+        void tick(juce::int64 time)
+        {
+            if (running)
+                ++position;
+
+            const bool gap = lastTick < 0 || time - lastTick > maxGapTicks * (locked ? period : maxTickPeriod * sampleRate);
+
+            if (gap)
+            {
+                // first tick, or the clock went away: wait for the next one
+                locked = false;
+            }
+            else if (!locked)
+            {
+                period = (double) (time - lastTick);
+                tickTime = (double) time;
+                locked = true;
+            }
+            else
+            {
+                const double predicted = tickTime + period;
+                const double error = (double) time - predicted;
+
+                // a tempo jump rather than jitter: lock again from this interval
+                if (std::abs(error) > 0.5 * period)
+                {
+                    period = (double) (time - lastTick);
+                    tickTime = (double) time;
+                }
+                else
+                {
+                    tickTime = predicted + alpha * error;
+                    period += beta * error;
+                }
+            }
+
+            lastTick = time;
+        }
+
+        // Locked and the clock is still coming in at time
+        bool isLocked(juce::int64 time) const
+        {
+            return locked && time - lastTick <= maxGapTicks * period;
+        }
+
+        bool isRunning() const
+        {
+            return running;
+        }
+
+        // Beats per second
+        double getRate() const
+        {
+            return sampleRate / (period * ticksPerBeat);
+        }
+
+        // Position within the beat at time, 0..1
+        double getPhase(juce::int64 time) const
+        {
+            const double beats = ((double) position + ((double) time - tickTime) / period) / ticksPerBeat;
+            return beats - std::floor(beats);
+        }
+
+    private:
+        // loop gains for a critically damped loop, beta = alpha^2 / 4
+        static constexpr double alpha = 0.2;
+        static constexpr double beta = alpha * alpha / 4.0;
+        static constexpr double maxGapTicks = 4.0;
+        static constexpr double maxTickPeriod = 0.1; // seconds, 25 BPM
+
+        double sampleRate = 44100.0;
+        double period = 0.0, tickTime = 0.0;
+        juce::int64 lastTick = -1, position = -1;
+        bool locked = false, running = false;
+    };
+}
@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    SampleBuffer.h
+    Created: 19 Oct 2026 10:02:31am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace Dsp
+{
+    // Channels of the engine's sample type for the sweep sources' output;
+    // juce::AudioBuffer only holds float or double. Contents are not kept
+    // across setSize.
+    template <typename SampleType>
+    class SampleBuffer
+    {
+    public:
+        void setSize(int newNumChannels, int newNumSamples)
+        {
+            numChannels = newNumChannels;
+            numSamples = newNumSamples;
+
+            data.allocate((size_t) numChannels * (size_t) numSamples, true);
+            channels.allocate((size_t) numChannels, false);
+
+            for (int i = 0; i < numChannels; i++)
+                channels[i] = data.get() + (size_t) i * (size_t) numSamples;
+        }
+
+        int getNumChannels() const
+        {
+            return numChannels;
+        }
+
+        int getNumSamples() const
+        {
+            return numSamples;
+        }
+
+        SampleType* getWritePointer(int channel)
+        {
+            jassert(juce::isPositiveAndBelow(channel, numChannels));
+            return channels[channel];
+        }
+
+        const SampleType* getReadPointer(int channel) const
+        {
+            jassert(juce::isPositiveAndBelow(channel, numChannels));
+            return channels[channel];
+        }
+
+        SampleType* const* getArrayOfWritePointers()
+        {
+            return channels.get();
+        }
+
+    private:
+        juce::HeapBlock<SampleType> data;
+        juce::HeapBlock<SampleType*> channels;
+        int numChannels = 0, numSamples = 0;
+    };
+}
@@ -0,0 +1,242 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyser.h
+    Created: 19 Oct 2026 9:26:07am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace Dsp
+{
+    // Input/output spectra for the editor. The audio thread only copies samples
+    // into lock-free FIFOs; windowing, FFT, averaging and decimation into
+    // log-spaced bands happen on the analyser's own thread.
+    class SpectrumAnalyser : private juce::Thread
+    {
+    public:
+        enum Stream
+        {
+            input = 0,
+            output,
+            numStreams
+        };
+
+        static constexpr int fftOrder = 11;
+        static constexpr int fftSize = 1 << fftOrder;
+        static constexpr int numBands = 128;
+        static constexpr float minDecibels = -90.0f;
+
+        SpectrumAnalyser() : juce::Thread("Spectrum analyser"),
+            fft(fftOrder),
+            window((size_t) fftSize, juce::dsp::WindowingFunction<float>::hann, false)
+        {
+            for (auto& s : streams)
+            {
+                for (auto& bands : s.published)
+                    juce::FloatVectorOperations::fill(bands, minDecibels, numBands);
+
+                juce::FloatVectorOperations::fill(s.average, 0.0f, fftSize / 2);
+            }
+        }
+
+        ~SpectrumAnalyser() override
+        {
+            stopThread(1000);
+        }
+
+        void prepare(double sampleRate)
+        {
+            const bool wasRunning = isThreadRunning();
+            stopThread(1000);
+
+            // band b covers bins [bandStart[b], bandStart[b + 1])
+            const double minFreq = 20.0, maxFreq = sampleRate / 2;
+
+            for (int b = 0; b <= numBands; b++)
+            {
+                const double freq = minFreq * pow(maxFreq / minFreq, (double) b / numBands);
+                bandStart[b] = juce::jlimit(1, fftSize / 2, juce::roundToInt(freq * fftSize / sampleRate));
+            }
+
+            for (auto& s : streams)
+            {
+                s.fifo.reset();
+                s.filled = 0;
+            }
+
+            if (wasRunning)
+                startThread();
+        }
+
+        // Message thread: the analyser only runs while somebody is looking.
+        void setEnabled(bool shouldBeEnabled)
+        {
+            enabled.store(shouldBeEnabled);
+
+            if (shouldBeEnabled)
+                startThread();
+            else
+                stopThread(1000);
+        }
+
+        // Audio thread: copies the channel average of the block into a FIFO.
+        void push(int stream, const juce::AudioBuffer<float>& buffer, int numChannels, int numSamples)
+        {
+            if (!enabled.load() || numChannels == 0)
+                return;
+
+            auto& s = streams[stream];
+            int start1, size1, start2, size2;
+            s.fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+            const float scale = 1.0f / numChannels;
+            const int sizes[] = { size1, size2 };
+            const int starts[] = { start1, start2 };
+            int offset = 0;
+
+            for (int region = 0; region < 2; region++)
+            {
+                if (sizes[region] <= 0)
+                    continue;
+
+                float* dest = s.fifoData + starts[region];
+                juce::FloatVectorOperations::copyWithMultiply(dest, buffer.getReadPointer(0, offset), scale, sizes[region]);
+
+                for (int channel = 1; channel < numChannels; channel++)
+                    juce::FloatVectorOperations::addWithMultiply(dest, buffer.getReadPointer(channel, offset), scale, sizes[region]);
+
+                offset += sizes[region];
+            }
+
+            s.fifo.finishedWrite(size1 + size2);
+        }
+
+        // Message thread: copies the latest bands, in dB, into dest[numBands].
+        // Returns false if nothing new was published since the last call. The
+        // slot copied from stays pinned until the next call.
+        bool getBands(int stream, float* dest)
+        {
+            auto& s = streams[stream];
+            const int version = s.version.load();
+
+            if (version == s.lastReadVersion)
+                return false;
+
+            s.lastReadVersion = version;
+
+            int index;
+
+            do
+            {
+                index = s.active.load();
+                s.inUse.store(index);
+            }
+            while (index != s.active.load());
+
+            juce::FloatVectorOperations::copy(dest, s.published[index], numBands);
+            return true;
+        }
+
+    private:
+        static constexpr int fifoSize = fftSize * 4;
+        static constexpr int hopSize = fftSize / 2;
+        static constexpr float averaging = 0.7f;
+
+        struct StreamState
+        {
+            juce::AbstractFifo fifo { fifoSize };
+            float fifoData[fifoSize];
+
+            float frame[fftSize];
+            int filled = 0;
+
+            float fftData[fftSize * 2];
+            float average[fftSize / 2];
+
+            float published[3][numBands];
+            std::atomic<int> active { 0 }, inUse { 0 };
+            std::atomic<int> version { 0 };
+            int lastReadVersion = -1;
+        };
+
+        void run() override
+        {
+            while (!threadShouldExit())
+            {
+                for (auto& s : streams)
+                    drain(s);
+
+                wait(15);
+            }
+        }
+
+        void drain(StreamState& s)
+        {
+            while (s.fifo.getNumReady() > 0)
+            {
+                int start1, size1, start2, size2;
+                s.fifo.prepareToRead(juce::jmin(s.fifo.getNumReady(), fftSize - s.filled), start1, size1, start2, size2);
+
+                juce::FloatVectorOperations::copy(s.frame + s.filled, s.fifoData + start1, size1);
+                juce::FloatVectorOperations::copy(s.frame + s.filled + size1, s.fifoData + start2, size2);
+
+                s.fifo.finishedRead(size1 + size2);
+                s.filled += size1 + size2;
+
+                if (s.filled == fftSize)
+                {
+                    analyse(s);
+
+                    // 50% overlap
+                    std::copy(s.frame + hopSize, s.frame + fftSize, s.frame);
+                    s.filled = fftSize - hopSize;
+                }
+            }
+        }
+
+        void analyse(StreamState& s)
+        {
+            juce::FloatVectorOperations::copy(s.fftData, s.frame, fftSize);
+            window.multiplyWithWindowingTable(s.fftData, (size_t) fftSize);
+            fft.performFrequencyOnlyForwardTransform(s.fftData);
+
+            // Hann window coherent gain is 0.5
+            juce::FloatVectorOperations::multiply(s.fftData, 4.0f / fftSize, fftSize / 2);
+            juce::FloatVectorOperations::multiply(s.average, averaging, fftSize / 2);
+            juce::FloatVectorOperations::addWithMultiply(s.average, s.fftData, 1.0f - averaging, fftSize / 2);
+
+            // a slot the message thread can't be reading
+            int next = 0;
+
+            while (next == s.active.load() || next == s.inUse.load())
+                next++;
+
+            float* bands = s.published[next];
+
+            for (int b = 0; b < numBands; b++)
+            {
+                float magnitude = 0.0f;
+
+                for (int bin = bandStart[b]; bin < juce::jmax(bandStart[b] + 1, bandStart[b + 1]); bin++)
+                    magnitude = juce::jmax(magnitude, s.average[juce::jmin(bin, fftSize / 2 - 1)]);
+
+                bands[b] = juce::Decibels::gainToDecibels(magnitude, minDecibels);
+            }
+
+            s.active.store(next);
+            ++s.version;
+        }
+
+        juce::dsp::FFT fft;
+        juce::dsp::WindowingFunction<float> window;
+        int bandStart[numBands + 1] = {};
+
+        StreamState streams[numStreams];
+        std::atomic<bool> enabled { false };
+    };
+}
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    SweepTable.h
+    Created: 19 Oct 2026 9:20:59am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Kernels.h"
+
+namespace Dsp
+{
+    // Maps a sweep position in 0..1 straight to the SVF coefficient
+    // F = 2 sin(pi f / fs), with f linear or exponential between the limits.
+    // The entries are stored in the filter kernel's coefficient format.
+    template <typename SampleType>
+    class BasicSweepTable
+    {
+    public:
+        using Kernel = SweepKernel<SampleType>;
+        using Coefficient = typename Kernel::Coefficient;
+
+        enum Mapping
+        {
+            linear = 0,
+            exponential
+        };
+
+        static constexpr int tableBits = 9;
+        static constexpr int tableSize = 1 << tableBits;
+
+        BasicSweepTable()
+        {
+            for (auto& table : tables)
+                table.allocate(tableSize + 1, true);
+        }
+
+        // Called from the message thread: fills a table the audio thread can't
+        // be reading, then makes it the active one.
+        void build(float minFreq, float maxFreq, int mapping, double sampleRate)
+        {
+            int next = 0;
+
+            while (next == active.load() || next == inUse.load())
+                next++;
+
+            fill(tables[next].get(), minFreq, maxFreq, mapping, sampleRate);
+            active.store(next);
+        }
+
+        // Fills tableSize + 1 values of an external table
+        static void fill(Coefficient* table, float minFreq, float maxFreq, int mapping, double sampleRate)
+        {
+            minFreq = juce::jmax(1.0f, minFreq);
+            maxFreq = juce::jmax(minFreq, maxFreq);
+
+            for (int i = 0; i <= tableSize; i++)
+            {
+                const float position = (float) i / tableSize;
+                const float f = (mapping == exponential) ? minFreq * pow(maxFreq / minFreq, position)
+                                                         : minFreq + (maxFreq - minFreq) * position;
+
+                table[i] = Kernel::makeCoefficient(2 * sin(juce::MathConstants<float>::pi * f / (float) sampleRate));
+            }
+        }
+
+        // Audio thread: take the active table once per block, pinned until
+        // the next call ...
+        const Coefficient* acquire()
+        {
+            int index;
+
+            do
+            {
+                index = active.load();
+                inUse.store(index);
+            }
+            while (index != active.load());
+
+            return tables[index].get();
+        }
+
+        // ... and read it per sample.
+        static Coefficient getCoefficient(const Coefficient* table, SampleType position)
+        {
+            return Kernel::template lookup<tableBits>(table, position);
+        }
+
+    private:
+        juce::HeapBlock<Coefficient> tables[3];
+        std::atomic<int> active { 0 }, inUse { 0 };
+    };
+
+    using SweepTable = BasicSweepTable<EngineSample>;
+}
@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+    TapTempo.h
+    Created: 19 Oct 2026 9:39:32am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace Dsp
+{
+    // Tempo from tap timestamps in samples: the period is the mean of the last
+    // few intervals, measured between accepted taps. A tap far from the median
+    // interval is held back: if the next tap lands on the old beat it was a
+    // stray and is dropped, if the next interval agrees with it the tempo
+    // changed. Fixed storage, no allocation.
+    class TapTempo
+    {
+    public:
+        static constexpr int maxIntervals = 8;
+        static constexpr double minInterval = 0.1;  // seconds; shorter is a double trigger
+        static constexpr double maxInterval = 2.0;  // seconds; longer starts a new sequence
+        static constexpr double outlierTolerance = 0.25;
+
+        void prepare(double newSampleRate)
+        {
+            sampleRate = newSampleRate;
+            reset();
+        }
+
+        void reset()
+        {
+            numIntervals = 0;
+            next = 0;
+            lastTap = -1;
+            heldTap = -1;
+        }
+
+        // Returns true when the tap gave a new period
+        bool tap(juce::int64 time)
+        {
+            if (lastTap < 0)
+            {
+                lastTap = time;
+                return false;
+            }
+
+            const double interval = (double) (time - lastTap);
+
+            if (interval < minInterval * sampleRate)
+                return false;
+
+            if (interval > maxInterval * sampleRate)
+            {
+                lastTap = time;
+                heldTap = -1;
+                numIntervals = 0;
+                return false;
+            }
+
+            if (numIntervals >= 2)
+            {
+                const double reference = getMedian();
+
+                if (std::abs(interval - reference) > outlierTolerance * reference)
+                {
+                    // two taps agreeing on a new interval: the tempo changed
+                    if (heldTap >= 0)
+                    {
+                        const double sinceHeld = (double) (time - heldTap);
+
+                        if (std::abs(sinceHeld - heldInterval) <= outlierTolerance * heldInterval)
+                        {
+                            numIntervals = 0;
+                            addInterval(heldInterval);
+                            return accept(time, sinceHeld);
+                        }
+                    }
+
+                    heldInterval = (double) (time - (heldTap >= 0 ? heldTap : lastTap));
+                    heldTap = time;
+                    return false;
+                }
+            }
+
+            return accept(time, interval);
+        }
+
+        // In samples
+        double getPeriod() const
+        {
+            return period;
+        }
+
+    private:
+        bool accept(juce::int64 time, double interval)
+        {
+            lastTap = time;
+            heldTap = -1;
+            addInterval(interval);
+
+            double sum = 0.0;
+
+            for (int i = 0; i < numIntervals; i++)
+                sum += intervals[(next - 1 - i + maxIntervals) % maxIntervals];
+
+            period = sum / numIntervals;
+            return true;
+        }
+
+        void addInterval(double interval)
+        {
+            intervals[next] = interval;
+            next = (next + 1) % maxIntervals;
+            numIntervals = juce::jmin(numIntervals + 1, maxIntervals);
+        }
+
+        double getMedian() const
+        {
+            double sorted[maxIntervals];
+
+            for (int i = 0; i < numIntervals; i++)
+                sorted[i] = intervals[(next - 1 - i + maxIntervals) % maxIntervals];
+
+            std::sort(sorted, sorted + numIntervals);
+
+            return (numIntervals % 2 == 1) ? sorted[numIntervals / 2]
+                                           : 0.5 * (sorted[numIntervals / 2 - 1] + sorted[numIntervals / 2]);
+        }
+
+        double sampleRate = 44100.0;
+        double intervals[maxIntervals] = {};
+        double period = 44100.0;
+        double heldInterval = 0.0;
+        int numIntervals = 0, next = 0;
+        juce::int64 lastTap = -1, heldTap = -1; // the last accepted tap, the one held back
+    };
+}
@@ -0,0 +1,200 @@
+/*
+  ==============================================================================
+
+    VowelMorphTable.h
+    Created: 19 Oct 2026 9:23:31am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "FormantBank.h"
+
+namespace Dsp
+{
+    // Formant bank coefficients for every morph position along a path of
+    // vowels (A -> E -> I ...), compiled into one contiguous table.
+    // Rebuilt on a background thread and swapped in for the audio thread,
+    // which only interpolates between neighbouring entries whatever the path length.
+    class VowelMorphTable : private juce::Thread
+    {
+    public:
+        static constexpr int maxPathLength = 8;
+        static constexpr int entriesPerStep = 256;
+        static constexpr int maxEntries = (maxPathLength - 1) * entriesPerStep;
+
+        struct Table
+        {
+            const FormantBank::Morph* entries;
+            int numEntries;
+        };
+
+        VowelMorphTable() : juce::Thread("Vowel morph table")
+        {
+            for (auto& table : tables)
+            {
+                table.resize(maxEntries);
+                jassert(reinterpret_cast<juce::pointer_sized_uint>(table.data()) % alignof(FormantBank::Morph) == 0);
+            }
+
+            for (auto& slot : requests)
+                for (auto& vowel : slot.path)
+                    vowel.store(0);
+        }
+
+        ~VowelMorphTable() override
+        {
+            stopThread(1000);
+        }
+
+        // Builds the table right away, then keeps the builder thread running.
+        void prepare(const int* path, int pathLength, float quality, double newSampleRate)
+        {
+            stopThread(1000);
+
+            sampleRate = newSampleRate;
+            request(path, pathLength, quality);
+            rebuild();
+
+            startThread();
+        }
+
+        // Message or audio thread (a program change): asks for a rebuild with a
+        // new path or quality. The request is written whole into its own slot
+        // and published by its ticket, so requests from both threads can't
+        // mix. Waking the builder takes its event's lock for a moment; the
+        // builder only holds it around its wait.
+        void request(const int* path, int pathLength, float quality)
+        {
+            pathLength = juce::jlimit(1, maxPathLength, pathLength);
+
+            const int ticket = ++requestTickets;
+            auto& slot = requests[ticket % numRequestSlots];
+
+            slot.ticket.store(-1);
+
+            for (int i = 0; i < pathLength; i++)
+                slot.path[i].store(path[i]);
+
+            slot.length.store(pathLength);
+            slot.quality.store(quality);
+            slot.ticket.store(ticket);
+
+            // the newest ticket wins, whichever thread publishes last
+            int published = latestRequest.load();
+
+            while (published < ticket && !latestRequest.compare_exchange_weak(published, ticket))
+            {
+            }
+
+            notify();
+        }
+
+        // Audio thread, once per block: pins the active table until the next call.
+        Table acquire()
+        {
+            int index;
+
+            do
+            {
+                index = active.load();
+                inUse.store(index);
+            }
+            while (index != active.load());
+
+            return { tables[index].data(), lengths[index] };
+        }
+
+        static const FormantBank::Morph& lookup(const Table& table, float position, float& frac)
+        {
+            const float pos = juce::jlimit(0.0f, 1.0f, position) * table.numEntries;
+            const int index = juce::jmin((int) pos, table.numEntries - 1);
+
+            frac = pos - index;
+            return table.entries[index];
+        }
+
+    private:
+        // Slots for requests in flight, more than the two threads that call
+        // request() can fill while the builder reads one
+        static constexpr int numRequestSlots = 4;
+
+        struct Request
+        {
+            std::atomic<int> ticket { 0 }; // -1 while written
+            std::atomic<int> path[maxPathLength];
+            std::atomic<int> length { 1 };
+            std::atomic<float> quality { 0.1f };
+        };
+
+        void run() override
+        {
+            while (!threadShouldExit())
+            {
+                wait(-1);
+
+                while (builtRequest != latestRequest.load() && !threadShouldExit())
+                    rebuild();
+            }
+        }
+
+        void rebuild()
+        {
+            builtRequest = latestRequest.load();
+
+            const auto& request = requests[builtRequest % numRequestSlots];
+            int path[maxPathLength];
+            int pathLength = request.length.load();
+            const float quality = request.quality.load();
+
+            for (int i = 0; i < pathLength; i++)
+                path[i] = request.path[i].load();
+
+            // rewritten while read: a newer request is on its way, with its
+            // own wake-up
+            if (request.ticket.load() != builtRequest)
+                return;
+
+            // a single vowel holds still
+            if (pathLength == 1)
+                path[pathLength++] = path[0];
+
+            // a slot the audio thread can't be reading
+            int slot = 0;
+
+            while (slot == active.load() || slot == inUse.load())
+                slot++;
+
+            FormantBank::Morph* table = tables[slot].data();
+            FormantBank::Coefficients start, end;
+
+            for (int step = 0; step < pathLength - 1; step++)
+            {
+                start.setMorph(path[step], path[step + 1], 0.0f, quality, sampleRate);
+
+                for (int i = 0; i < entriesPerStep; i++)
+                {
+                    end.setMorph(path[step], path[step + 1], (float) (i + 1) / entriesPerStep, quality, sampleRate);
+                    table[step * entriesPerStep + i].set(start, end);
+                    start = end;
+                }
+            }
+
+            lengths[slot] = (pathLength - 1) * entriesPerStep;
+            active.store(slot);
+        }
+
+        // Morph holds SIMD registers: std::vector's allocator honours their
+        // alignment (C++17 aligned new), a HeapBlock's malloc doesn't
+        std::vector<FormantBank::Morph> tables[3];
+        int lengths[3] = { entriesPerStep, entriesPerStep, entriesPerStep };
+        std::atomic<int> active { 0 }, inUse { 0 };
+
+        double sampleRate = 44100.0;
+        Request requests[numRequestSlots];
+        std::atomic<int> requestTickets { 0 }, latestRequest { 0 };
+        int builtRequest = -1;
+    };
+}
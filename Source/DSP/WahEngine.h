@@ -0,0 +1,241 @@
+/*
+  ==============================================================================
+
+    WahEngine.h
+    Created: 19 Oct 2026 9:36:09am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Crossover.h"
+#include "FormantBank.h"
+#include "Kernels.h"
+#include "SweepTable.h"
+#include "VowelMorphTable.h"
+#include "../Diagnostics/Trace.h"
+
+namespace Dsp
+{
+    // The wah's filter section: per channel state variable filter or formant
+    // bank, then the output mix. The processor keeps two of these so a change
+    // the filter state can't follow smoothly crossfades into a fresh engine.
+    // Optionally only one side of a crossover is wahed, the other band passes
+    // through; the split runs inside the filter's own sample loop.
+    // SampleType selects the state variable filter kernel, float or Q31, and
+    // the type of the sweep positions and table; the crossover and the
+    // formant bank are float either way.
+    template <typename SampleType>
+    class BasicWahEngine
+    {
+    public:
+        using Svf = SvfKernel<SampleType>;
+        using Sweep = BasicSweepTable<SampleType>;
+        using Coefficient = typename Sweep::Coefficient;
+
+        enum Band
+        {
+            fullBand = 0,
+            highBand,
+            lowBand
+        };
+
+        struct Parameters
+        {
+            int mode = 0, filter = 0, band = fullBand;
+            bool humanizer = false;
+            float Q = 0.1f, gain = 1.0f, wet = 0.5f, dry = 0.5f;
+            float crossover = 250.0f;
+
+            // switches that would run the old filter state through a new topology
+            bool needsCrossfade(const Parameters& other) const
+            {
+                return mode != other.mode || filter != other.filter || humanizer != other.humanizer || band != other.band;
+            }
+        };
+
+        Parameters parameters;
+
+        void prepare(double newSampleRate, int numChannels, int maxBlockSize)
+        {
+            sampleRate = newSampleRate;
+            formantBanks.clear();
+
+            for (int i = 0; i < numChannels; i++)
+                formantBanks.add(new FormantBank());
+
+            svfStates.resize(numChannels);
+            crossovers.resize(numChannels);
+            setScratchSize(maxBlockSize);
+
+            reset();
+        }
+
+        void reset()
+        {
+            svfStates.fill(typename Svf::State());
+            crossovers.fill(Crossover());
+
+            for (auto* bank : formantBanks)
+                bank->reset();
+        }
+
+        // One channel from in to out, which may be the same buffer. positions
+        // are this channel's LFO (tempo) or envelope (dynamic) values; with
+        // shareCoefficients the sweep coefficients of the previous channel are
+        // reused, for stereo-linked channels.
+        void process(int channel, const float* in, float* out, int numSamples, const SampleType* positions,
+                     const Coefficient* sweep, const VowelMorphTable::Table& vowelMorph, bool shareCoefficients)
+        {
+            if (scratch.getNumSamples() < numSamples)
+                setScratchSize(numSamples);
+
+            Coefficient* coeffs = coefficients.get();
+            SampleType* wetSamples = filterSamples.get();
+            float* wetData = scratch.getWritePointer(0);
+            float* bandData = scratch.getWritePointer(1); // the wahed band, dry
+            float* restData = scratch.getWritePointer(2); // the band passing through
+
+            const bool split = parameters.band != fullBand;
+            const bool wahLows = parameters.band == lowBand;
+            const auto crossoverCoefficients = Crossover::Coefficients::make(parameters.crossover, sampleRate);
+            auto crossover = crossovers[channel];
+
+            // returns the input to wah, keeping both bands for the output mix
+            auto splitInput = [&](int i)
+            {
+                float high;
+                const float low = crossover.process(in[i], high, crossoverCoefficients);
+
+                bandData[i] = wahLows ? low : high;
+                restData[i] = wahLows ? high : low;
+                return bandData[i];
+            };
+
+            if (parameters.humanizer)
+            {
+                WAH_TRACE_SCOPE("formant bank");
+
+                for (int i = 0; i < numSamples; i++)
+                {
+                    const float x = split ? splitInput(i) : in[i];
+
+                    // tempo sweeps -1..1, dynamic 0..1
+                    const float position = Sweep::Kernel::positionToFloat(parameters.mode == 0 ? Sweep::Kernel::fromBipolar(positions[i])
+                                                                                               : positions[i]);
+
+                    float frac;
+                    const auto& morph = VowelMorphTable::lookup(vowelMorph, position, frac);
+                    wetData[i] = formantBanks[channel]->process(x, morph, frac, parameters.filter);
+                }
+            }
+            else
+            {
+                // sweep position to F
+                if (!shareCoefficients)
+                {
+                    WAH_TRACE_SCOPE("coefficients");
+
+                    for (int i = 0; i < numSamples; i++)
+                    {
+                        auto position = positions[i];
+
+                        if (parameters.mode == 0)
+                            position = Sweep::Kernel::fromBipolar(position);
+
+                        coeffs[i] = Sweep::getCoefficient(sweep, position);
+                    }
+                }
+
+                // state variable filter
+                {
+                    WAH_TRACE_SCOPE("svf");
+
+                    const auto Q = Svf::makeDamping(parameters.Q);
+                    auto state = svfStates[channel];
+
+                    // into the filter's sample type once at the input; a split
+                    // band converts as it leaves the crossover
+                    const SampleType* x = split ? nullptr : Svf::toSamples(in, inputSamples.get(), numSamples);
+
+                    for (int i = 0; i < numSamples; i++)
+                    {
+                        const SampleType xi = split ? Svf::toSample(splitInput(i)) : x[i];
+                        wetSamples[i] = Svf::process(state, xi, coeffs[i], Q, parameters.filter);
+                    }
+
+                    svfStates.set(channel, state);
+                }
+
+                if (channel == 0 && numSamples > 0)
+                    lastCoefficient = Sweep::Kernel::coefficientToFloat(coeffs[numSamples - 1]);
+            }
+
+            crossovers.set(channel, crossover);
+
+            // output
+            {
+                WAH_TRACE_SCOPE("output mix");
+
+                juce::FloatVectorOperations::copyWithMultiply(out, split ? bandData : in, parameters.gain * parameters.dry, numSamples);
+
+                // the filter's output back to float on the way
+                if (parameters.humanizer)
+                    juce::FloatVectorOperations::addWithMultiply(out, wetData, parameters.gain * parameters.wet, numSamples);
+                else
+                    Svf::addToOutput(out, wetSamples, parameters.gain * parameters.wet, numSamples);
+
+                if (split)
+                    juce::FloatVectorOperations::addWithMultiply(out, restData, parameters.gain, numSamples);
+            }
+        }
+
+        // Largest filter state magnitude over all channels, for telling when
+        // the filter has rung out
+        float getStateMagnitude() const
+        {
+            float magnitude = 0.0f;
+
+            if (parameters.humanizer)
+            {
+                for (auto* bank : formantBanks)
+                    magnitude = juce::jmax(magnitude, bank->getStateMagnitude());
+            }
+            else
+            {
+                for (const auto& state : svfStates)
+                    magnitude = juce::jmax(magnitude, state.getMagnitude());
+            }
+
+            return magnitude;
+        }
+
+        // F the sweep ended the last block of channel 0 on
+        float getLastCoefficient() const
+        {
+            return lastCoefficient;
+        }
+
+    private:
+        void setScratchSize(int numSamples)
+        {
+            scratch.setSize(3, numSamples, false, false, true);
+            coefficients.allocate((size_t) numSamples, true);
+            inputSamples.allocate((size_t) numSamples, true);
+            filterSamples.allocate((size_t) numSamples, true);
+        }
+
+        double sampleRate = 44100.0;
+        juce::Array<typename Svf::State> svfStates;
+        juce::Array<Crossover> crossovers;
+        juce::OwnedArray<FormantBank> formantBanks;
+        juce::AudioBuffer<float> scratch;
+        juce::HeapBlock<Coefficient> coefficients;
+        juce::HeapBlock<SampleType> inputSamples, filterSamples;
+        float lastCoefficient = 0.0f;
+    };
+
+    using WahEngine = BasicWahEngine<EngineSample>;
+}
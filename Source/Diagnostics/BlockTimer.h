@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+    BlockTimer.h
+    Created: 19 Oct 2026 9:28:18am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace Diagnostics
+{
+    // Per-block processing time of the audio thread, kept in a lock-free ring
+    // buffer: the audio thread only reads the high-resolution counter twice and
+    // writes one entry, everything else happens on the reading side.
+    class BlockTimer
+    {
+    public:
+        static constexpr int numEntries = 1024;
+
+        struct Entry
+        {
+            float seconds, budgetSeconds;
+        };
+
+        struct Stats
+        {
+            int numBlocks = 0;
+            double min = 0.0, mean = 0.0, p99 = 0.0, max = 0.0;
+            double meanLoad = 0.0, maxLoad = 0.0; // percentage of the realtime budget
+        };
+
+        // Times the enclosing scope and records it against the block's budget
+        class ScopedMeasurement
+        {
+        public:
+            ScopedMeasurement(BlockTimer& t, int numSamples, double sampleRate)
+                : timer(t), budgetSeconds(sampleRate > 0.0 ? (float) (numSamples / sampleRate) : 0.0f),
+                  startTicks(juce::Time::getHighResolutionTicks())
+            {
+            }
+
+            ~ScopedMeasurement()
+            {
+                const auto elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+                timer.record((float) elapsed, budgetSeconds);
+            }
+
+        private:
+            BlockTimer& timer;
+            const float budgetSeconds;
+            const juce::int64 startTicks;
+
+            JUCE_DECLARE_NON_COPYABLE(ScopedMeasurement)
+        };
+
+        // Audio thread
+        void record(float seconds, float budgetSeconds)
+        {
+            const auto count = writeCount.load(std::memory_order_relaxed);
+            entries[count % numEntries] = { seconds, budgetSeconds };
+            writeCount.store(count + 1, std::memory_order_release);
+        }
+
+        // Message thread: copies the most recent entries, oldest first, and
+        // returns how many there were.
+        int getEntries(Entry* dest) const
+        {
+            const auto count = writeCount.load(std::memory_order_acquire);
+            const int num = (int) juce::jmin<juce::uint64>(count, numEntries);
+
+            for (int i = 0; i < num; i++)
+                dest[i] = entries[(count - num + i) % numEntries];
+
+            return num;
+        }
+
+        // Message thread
+        Stats getStats() const
+        {
+            Stats stats;
+            Entry snapshot[numEntries];
+            float seconds[numEntries];
+
+            stats.numBlocks = getEntries(snapshot);
+
+            if (stats.numBlocks == 0)
+                return stats;
+
+            stats.min = snapshot[0].seconds;
+
+            for (int i = 0; i < stats.numBlocks; i++)
+            {
+                const auto& e = snapshot[i];
+                const double load = e.budgetSeconds > 0.0f ? 100.0 * e.seconds / e.budgetSeconds : 0.0;
+
+                seconds[i] = e.seconds;
+                stats.min = juce::jmin(stats.min, (double) e.seconds);
+                stats.max = juce::jmax(stats.max, (double) e.seconds);
+                stats.mean += e.seconds;
+                stats.meanLoad += load;
+                stats.maxLoad = juce::jmax(stats.maxLoad, load);
+            }
+
+            stats.mean /= stats.numBlocks;
+            stats.meanLoad /= stats.numBlocks;
+
+            const int p99Index = juce::jmin(stats.numBlocks - 1, (int) (0.99 * stats.numBlocks));
+            std::nth_element(seconds, seconds + p99Index, seconds + stats.numBlocks);
+            stats.p99 = seconds[p99Index];
+
+            return stats;
+        }
+
+        // Message thread: one line per block, oldest first
+        bool writeCsv(const juce::File& file) const
+        {
+            Entry snapshot[numEntries];
+            const int num = getEntries(snapshot);
+
+            juce::String csv("block,time_us,budget_us,load_percent\n");
+
+            for (int i = 0; i < num; i++)
+            {
+                const auto& e = snapshot[i];
+                const double load = e.budgetSeconds > 0.0f ? 100.0 * e.seconds / e.budgetSeconds : 0.0;
+
+                csv << i << ',' << juce::String(e.seconds * 1.0e6, 2) << ',' << juce::String(e.budgetSeconds * 1.0e6, 2)
+                    << ',' << juce::String(load, 2) << '\n';
+            }
+
+            return file.replaceWithText(csv);
+        }
+
+    private:
+        Entry entries[numEntries] = {};
+        std::atomic<juce::uint64> writeCount { 0 };
+    };
+}
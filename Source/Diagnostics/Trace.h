@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+    Trace.h
+    Created: 19 Oct 2026 9:29:49am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Trace points are compiled in for debug builds only, unless the project
+// defines WAH_ENABLE_TRACING explicitly.
+#ifndef WAH_ENABLE_TRACING
+ #if JUCE_DEBUG
+  #define WAH_ENABLE_TRACING 1
+ #else
+  #define WAH_ENABLE_TRACING 0
+ #endif
+#endif
+
+#if WAH_ENABLE_TRACING
+
+namespace Diagnostics
+{
+    // Timestamped scope events in one ring buffer per thread, exported as
+    // Chrome trace JSON (chrome://tracing, ui.perfetto.dev).
+    class Trace
+    {
+    public:
+        static constexpr int eventsPerThread = 8192;
+
+        struct Event
+        {
+            const char* name; // string literal
+            juce::int64 startTicks, endTicks;
+        };
+
+        class ScopedEvent
+        {
+        public:
+            explicit ScopedEvent(const char* eventName)
+                : name(eventName), startTicks(juce::Time::getHighResolutionTicks())
+            {
+            }
+
+            ~ScopedEvent()
+            {
+                getThreadBuffer().record({ name, startTicks, juce::Time::getHighResolutionTicks() });
+            }
+
+        private:
+            const char* name;
+            const juce::int64 startTicks;
+
+            JUCE_DECLARE_NON_COPYABLE(ScopedEvent)
+        };
+
+        // Message thread: writes every thread's recent events
+        static bool writeChromeJson(const juce::File& file)
+        {
+            auto& registry = getRegistry();
+            const juce::ScopedLock sl(registry.lock);
+
+            const double ticksPerMicrosecond = juce::Time::getHighResolutionTicksPerSecond() / 1.0e6;
+            juce::String json("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+            bool first = true;
+
+            auto append = [&json, &first](const juce::String& event)
+            {
+                if (!first)
+                    json << ",\n";
+
+                json << event;
+                first = false;
+            };
+
+            for (int t = 0; t < registry.buffers.size(); t++)
+            {
+                const auto* buffer = registry.buffers[t];
+
+                append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + juce::String(t)
+                       + ",\"args\":{\"name\":\"" + buffer->threadName + "\"}}");
+
+                const auto count = buffer->writeCount.load(std::memory_order_acquire);
+                const int num = (int) juce::jmin<juce::uint64>(count, eventsPerThread);
+
+                for (int i = 0; i < num; i++)
+                {
+                    const auto& e = buffer->events[(count - num + i) % eventsPerThread];
+                    const double ts = (e.startTicks - registry.originTicks) / ticksPerMicrosecond;
+                    const double dur = (e.endTicks - e.startTicks) / ticksPerMicrosecond;
+
+                    append("{\"name\":\"" + juce::String(e.name) + "\",\"ph\":\"X\",\"pid\":1,\"tid\":" + juce::String(t)
+                           + ",\"ts\":" + juce::String(ts, 3) + ",\"dur\":" + juce::String(dur, 3) + "}");
+                }
+            }
+
+            json << "\n]}\n";
+
+            return file.replaceWithText(json);
+        }
+
+    private:
+        struct ThreadBuffer
+        {
+            // Owning thread only
+            void record(const Event& e)
+            {
+                const auto count = writeCount.load(std::memory_order_relaxed);
+                events[count % eventsPerThread] = e;
+                writeCount.store(count + 1, std::memory_order_release);
+            }
+
+            juce::String threadName;
+            Event events[eventsPerThread] = {};
+            std::atomic<juce::uint64> writeCount { 0 };
+        };
+
+        struct Registry
+        {
+            juce::CriticalSection lock;
+            juce::OwnedArray<ThreadBuffer> buffers; // kept until exit, so threads may come and go
+            const juce::int64 originTicks = juce::Time::getHighResolutionTicks();
+        };
+
+        static Registry& getRegistry()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        // The first event on a thread allocates and registers its buffer; every
+        // later one is lock-free.
+        static ThreadBuffer& getThreadBuffer()
+        {
+            thread_local ThreadBuffer* buffer = []()
+            {
+                auto& registry = getRegistry();
+                auto* newBuffer = new ThreadBuffer();
+
+                if (auto* thread = juce::Thread::getCurrentThread())
+                    newBuffer->threadName = thread->getThreadName();
+                else if (juce::MessageManager::existsAndIsCurrentThread())
+                    newBuffer->threadName = "Message thread";
+                else
+                    newBuffer->threadName = "Audio thread";
+
+                const juce::ScopedLock sl(registry.lock);
+                return registry.buffers.add(newBuffer);
+            }();
+
+            return *buffer;
+        }
+    };
+}
+
+ #define WAH_TRACE_SCOPE(name) const Diagnostics::Trace::ScopedEvent JUCE_JOIN_MACRO(traceEvent_, __LINE__) (name)
+#else
+ #define WAH_TRACE_SCOPE(name)
+#endif
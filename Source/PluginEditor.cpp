@@ -17,8 +17,7 @@
 //==============================================================================
 WahAudioProcessorEditor::WahAudioProcessorEditor (WahAudioProcessor& p)
     : AudioProcessorEditor (&p), audioProcessor (p),
-    verticalGradientMeterL([&]() { return audioProcessor.getRmsValue(0); }),
-    verticalGradientMeterR([&]() { return audioProcessor.getRmsValue(1); })
+    shapeDrawer([&](const float* points, int numPoints) { audioProcessor.set_userShape(points, numPoints); })
 {
     // Make sure that before the constructor has finished, you've set the
     // editor's size to whatever you need it to be.
@@ -27,12 +26,39 @@ WahAudioProcessorEditor::WahAudioProcessorEditor (WahAudioProcessor& p)
     
     setSize (800, 700);
 
+   #if JUCE_MAJOR_VERSION < 7
     startTimerHz(24);
+   #endif
 
     tapButton.setButtonText("TAP");
     tapButton.setSize(90, 90);
     tapButton.onClick = [this]() { tapClicked(); };
 
+    cpuButton.setButtonText("CPU");
+    cpuButton.setClickingTogglesState(true);
+    cpuButton.setColour(juce::TextButton::buttonOnColourId, juce::Colours::steelblue);
+    cpuButton.setColour(juce::TextButton::buttonColourId, juce::Colours::steelblue.brighter(0.8f));
+    cpuButton.setColour(juce::TextButton::textColourOnId, juce::Colours::steelblue.brighter(0.8f));
+    cpuButton.setColour(juce::TextButton::textColourOffId, juce::Colours::steelblue);
+    cpuButton.onClick = [this]() { cpuButtonToggle(); };
+
+    csvButton.setButtonText("CSV");
+    csvButton.setColour(juce::TextButton::buttonColourId, juce::Colours::steelblue.brighter(0.8f));
+    csvButton.setColour(juce::TextButton::textColourOffId, juce::Colours::steelblue);
+    csvButton.onClick = [this]() { csvClicked(); };
+
+   #if WAH_ENABLE_TRACING
+    traceButton.setButtonText("Trace");
+    traceButton.setColour(juce::TextButton::buttonColourId, juce::Colours::steelblue.brighter(0.8f));
+    traceButton.setColour(juce::TextButton::textColourOffId, juce::Colours::steelblue);
+    traceButton.onClick = [this]() { traceClicked(); };
+   #endif
+
+    cpuLabel.setColour(juce::Label::backgroundColourId, juce::Colours::black);
+    cpuLabel.setColour(juce::Label::textColourId, juce::Colours::white);
+    cpuLabel.setJustificationType(juce::Justification::centred);
+    cpuLabel.setFont(juce::Font(11.0f));
+
     interval_ms.setColour(juce::Label::backgroundColourId, juce::Colours::black);
     interval_ms.setColour(juce::Label::textColourId, juce::Colours::white);
     interval_ms.setJustificationType(juce::Justification::centred);
@@ -80,6 +106,28 @@ WahAudioProcessorEditor::WahAudioProcessorEditor (WahAudioProcessor& p)
     gainSlider.setValue(1.0);
     gainSlider.addListener(this);
 
+    lookaheadSlider.setSliderStyle(juce::Slider::LinearHorizontal);
+    lookaheadSlider.setRange(0.0, 10.0, 0.1);
+    lookaheadSlider.setTextBoxStyle(juce::Slider::TextBoxRight, true, 64, 30);
+    lookaheadSlider.setTextValueSuffix(" ms");
+    lookaheadSlider.setValue(0.0);
+    lookaheadSlider.addListener(this);
+
+    crossoverSlider.setSliderStyle(juce::Slider::LinearHorizontal);
+    crossoverSlider.setRange(40.0, 2000.0, 1.0);
+    crossoverSlider.setSkewFactorFromMidPoint(300.0);
+    crossoverSlider.setTextBoxStyle(juce::Slider::TextBoxRight, true, 64, 30);
+    crossoverSlider.setTextValueSuffix(" Hz");
+    crossoverSlider.setValue(250.0);
+    crossoverSlider.addListener(this);
+
+    stereoPhaseSlider.setSliderStyle(juce::Slider::LinearHorizontal);
+    stereoPhaseSlider.setRange(0.0, 180.0, 1.0);
+    stereoPhaseSlider.setTextBoxStyle(juce::Slider::TextBoxRight, true, 64, 30);
+    stereoPhaseSlider.setTextValueSuffix(juce::String(juce::CharPointer_UTF8("\xc2\xb0")));
+    stereoPhaseSlider.setValue(0.0);
+    stereoPhaseSlider.addListener(this);
+
     depthLabel.setText("Depth", juce::dontSendNotification);
     depthLabel.attachToComponent(&depthSlider, false);
     depthLabel.setJustificationType(juce::Justification::centredTop);
@@ -109,6 +157,9 @@ WahAudioProcessorEditor::WahAudioProcessorEditor (WahAudioProcessor& p)
     gainLabel.setJustificationType(juce::Justification::horizontallyCentred);
     gainLabel.setFont(juce::Font("Calibri", 20.0f, juce::Font::italic));
 
+    lookaheadLabel.setText("Lookahead", juce::dontSendNotification);
+    lookaheadLabel.attachToComponent(&lookaheadSlider, true);
+
     humanizerLabel.setText("Humanizer", juce::dontSendNotification);
     //humanizerLabel.attachToComponent(&humanizerButton, false);
     humanizerLabel.setJustificationType(juce::Justification::centredTop);
@@ -134,6 +185,105 @@ WahAudioProcessorEditor::WahAudioProcessorEditor (WahAudioProcessor& p)
     filterType.addItem("HighPass", 3);
     filterType.addListener(this);
 
+    linkType.setJustificationType(juce::Justification::centred);
+    linkType.setColour(juce::ComboBox::backgroundColourId, juce::Colours::steelblue.brighter(0.8f));
+    linkType.setColour(juce::ComboBox::textColourId, juce::Colours::steelblue.darker(0.6));
+    linkType.addItem("Stereo Link Off", 1);
+    linkType.addItem("Stereo Link Max", 2);
+    linkType.addItem("Stereo Link Mean", 3);
+    linkType.setSelectedId(1, juce::dontSendNotification);
+    linkType.addListener(this);
+
+    detectorType.setJustificationType(juce::Justification::centred);
+    detectorType.setColour(juce::ComboBox::backgroundColourId, juce::Colours::steelblue.brighter(0.8f));
+    detectorType.setColour(juce::ComboBox::textColourId, juce::Colours::steelblue.darker(0.6));
+    detectorType.addItem("Peak Detector", 1);
+    detectorType.addItem("RMS Detector", 2);
+    detectorType.addItem("Log Detector", 3);
+    detectorType.setSelectedId(1, juce::dontSendNotification);
+    detectorType.addListener(this);
+
+    lfoShape.setJustificationType(juce::Justification::centred);
+    lfoShape.setColour(juce::ComboBox::backgroundColourId, juce::Colours::steelblue.brighter(0.8f));
+    lfoShape.setColour(juce::ComboBox::textColourId, juce::Colours::steelblue.darker(0.6));
+    lfoShape.addItem("Sine", 1);
+    lfoShape.addItem("Triangle", 2);
+    lfoShape.addItem("Saw Up", 3);
+    lfoShape.addItem("Saw Down", 4);
+    lfoShape.addItem("Square", 5);
+    lfoShape.addItem("Random", 6);
+    lfoShape.addItem("Drawn", 7);
+    lfoShape.setSelectedId(1, juce::dontSendNotification);
+    lfoShape.addListener(this);
+
+    sweepMapping.setJustificationType(juce::Justification::centred);
+    sweepMapping.setColour(juce::ComboBox::backgroundColourId, juce::Colours::steelblue.brighter(0.8f));
+    sweepMapping.setColour(juce::ComboBox::textColourId, juce::Colours::steelblue.darker(0.6));
+    sweepMapping.addItem("Linear Sweep", 1);
+    sweepMapping.addItem("Exponential Sweep", 2);
+    sweepMapping.setSelectedId(1, juce::dontSendNotification);
+    sweepMapping.addListener(this);
+
+    bandSplit.setJustificationType(juce::Justification::centred);
+    bandSplit.setColour(juce::ComboBox::backgroundColourId, juce::Colours::steelblue.brighter(0.8f));
+    bandSplit.setColour(juce::ComboBox::textColourId, juce::Colours::steelblue.darker(0.6));
+    bandSplit.addItem("Wah Full Band", 1);
+    bandSplit.addItem("Wah Above Crossover", 2);
+    bandSplit.addItem("Wah Below Crossover", 3);
+    bandSplit.setSelectedId(1, juce::dontSendNotification);
+    bandSplit.addListener(this);
+
+    stereoMode.setJustificationType(juce::Justification::centred);
+    stereoMode.setColour(juce::ComboBox::backgroundColourId, juce::Colours::steelblue.brighter(0.8f));
+    stereoMode.setColour(juce::ComboBox::textColourId, juce::Colours::steelblue.darker(0.6));
+    stereoMode.addItem("Stereo Offset", 1);
+    stereoMode.addItem("Stereo Spread", 2);
+    stereoMode.setSelectedId(1, juce::dontSendNotification);
+    stereoMode.addListener(this);
+
+    // the MIDI note that taps, ids are note number + 1
+    tapNote.setJustificationType(juce::Justification::centred);
+    tapNote.setColour(juce::ComboBox::backgroundColourId, juce::Colours::steelblue.brighter(0.8f));
+    tapNote.setColour(juce::ComboBox::textColourId, juce::Colours::steelblue.darker(0.6));
+    for (int note = 0; note < 128; note++)
+        tapNote.addItem(juce::MidiMessage::getMidiNoteName(note, true, true, 3), note + 1);
+    tapNote.setSelectedId(State::Settings().tapNote + 1, juce::dontSendNotification);
+    tapNote.addListener(this);
+
+    tapChannel.setJustificationType(juce::Justification::centred);
+    tapChannel.setColour(juce::ComboBox::backgroundColourId, juce::Colours::steelblue.brighter(0.8f));
+    tapChannel.setColour(juce::ComboBox::textColourId, juce::Colours::steelblue.darker(0.6));
+    tapChannel.addItem("Any Ch", 1);
+    for (int channel = 1; channel <= 16; channel++)
+        tapChannel.addItem("Ch " + juce::String(channel), channel + 1);
+    tapChannel.setSelectedId(State::Settings().tapChannel + 1, juce::dontSendNotification);
+    tapChannel.addListener(this);
+
+    vowelPathEditor.setJustification(juce::Justification::centred);
+    vowelPathEditor.setInputRestrictions(Dsp::VowelMorphTable::maxPathLength, "AEIOUaeiou");
+    vowelPathEditor.setTextToShowWhenEmpty("Vowel path e.g. AEIOU", juce::Colours::grey);
+    vowelPathEditor.setText("AA", false);
+    vowelPathEditor.onReturnKey = [this]() { vowelPathChanged(); };
+    vowelPathEditor.onFocusLost = [this]() { vowelPathChanged(); };
+
+    presetSearch.setTextToShowWhenEmpty("Search presets", juce::Colours::grey);
+    presetSearch.onTextChange = [this]() { updatePresetList(); };
+
+    presetList.setTextWhenNothingSelected("User Presets");
+    presetList.setTextWhenNoChoicesAvailable("No Presets");
+    presetList.setColour(juce::ComboBox::backgroundColourId, juce::Colours::steelblue.brighter(0.8f));
+    presetList.setColour(juce::ComboBox::textColourId, juce::Colours::steelblue.darker(0.6));
+    presetList.addListener(this);
+    updatePresetList();
+
+    presetName.setTextToShowWhenEmpty("Name #tag", juce::Colours::grey);
+    presetName.onReturnKey = [this]() { savePreset(); };
+
+    presetSave.setButtonText("Save");
+    presetSave.setColour(juce::TextButton::buttonColourId, juce::Colours::steelblue.brighter(0.8f));
+    presetSave.setColour(juce::TextButton::textColourOffId, juce::Colours::steelblue);
+    presetSave.onClick = [this]() { savePreset(); };
+
     firstVowel.setToggleState(true, juce::dontSendNotification);
     firstVowel.setClickingTogglesState(false);
     firstVowel.setColour(juce::TextButton::buttonOnColourId, juce::Colours::red.darker(0.2f));
@@ -165,49 +315,142 @@ WahAudioProcessorEditor::WahAudioProcessorEditor (WahAudioProcessor& p)
     addAndMakeVisible(attackSlider);
     addAndMakeVisible(mixSlider);
     addAndMakeVisible(gainSlider);
+    addAndMakeVisible(lookaheadSlider);
     addAndMakeVisible(depthLabel);
     addAndMakeVisible(qualityLabel);
     addAndMakeVisible(decayLabel);
     addAndMakeVisible(attackLabel);
     addAndMakeVisible(mixLabel);
     addAndMakeVisible(gainLabel);
+    addAndMakeVisible(lookaheadLabel);
     addAndMakeVisible(humanizerButton);
     addAndMakeVisible(humanizerLabel);
     addAndMakeVisible(filterType);
+    addAndMakeVisible(linkType);
+    addAndMakeVisible(detectorType);
+    addAndMakeVisible(lfoShape);
+    addAndMakeVisible(sweepMapping);
+    addAndMakeVisible(bandSplit);
+    addAndMakeVisible(crossoverSlider);
+    addAndMakeVisible(stereoMode);
+    addAndMakeVisible(tapNote);
+    addAndMakeVisible(tapChannel);
+    addAndMakeVisible(stereoPhaseSlider);
+    addAndMakeVisible(vowelPathEditor);
+    addChildComponent(shapeDrawer);
+    addAndMakeVisible(spectrumDisplay);
+    addAndMakeVisible(responseCurve);
+    addAndMakeVisible(presetSearch);
+    addAndMakeVisible(presetList);
+    addAndMakeVisible(presetName);
+    addAndMakeVisible(presetSave);
     addAndMakeVisible(firstVowel);
     addAndMakeVisible(secondVowel);
     addAndMakeVisible(mode);
     addAndMakeVisible(tapButton);
     addAndMakeVisible(interval_ms);
+    addAndMakeVisible(cpuButton);
+    addAndMakeVisible(csvButton);
+    addChildComponent(cpuLabel);
+   #if WAH_ENABLE_TRACING
+    addAndMakeVisible(traceButton);
+   #endif
     //addAndMakeVisible(horizontalMeterL);
     //addAndMakeVisible(horizontalMeterR);
     addAndMakeVisible(verticalGradientMeterL);
     addAndMakeVisible(verticalGradientMeterR);
 
+    audioProcessor.setAnalyserEnabled(true);
+
+    setOpaque(true);
     setResizable(true, true);
     setResizeLimits(500, 350, 2000, 1400);
     getConstrainer()->setFixedAspectRatio(1.45);
 
+    syncControls();
+
 }
 
 WahAudioProcessorEditor::~WahAudioProcessorEditor()
 {
+    audioProcessor.setAnalyserEnabled(false);
 }
 
 void WahAudioProcessorEditor::timerCallback()
 {
-    horizontalMeterL.setLevel(audioProcessor.getRmsValue(0));
-    horizontalMeterR.setLevel(audioProcessor.getRmsValue(1));
+    refresh();
+}
+
+void WahAudioProcessorEditor::refresh()
+{
+    if (audioProcessor.getSettingsGeneration() != settingsGeneration)
+        syncControls();
+
+    const int bpm = juce::roundToInt(audioProcessor.getRate() * 60.0f);
+
+    if (bpm != displayedBpm)
+    {
+        displayedBpm = bpm;
+        interval_ms.setText(juce::String(bpm), juce::dontSendNotification);
+    }
+
+    const auto levelL = audioProcessor.getRmsValue(0);
+    const auto levelR = audioProcessor.getRmsValue(1);
+
+    if (verticalGradientMeterL.isVisible())
+        verticalGradientMeterL.setLevel(levelL);
+    if (verticalGradientMeterR.isVisible())
+        verticalGradientMeterR.setLevel(levelR);
+
+    if (horizontalMeterL.isVisible())
+        horizontalMeterL.setLevel(levelL);
+    if (horizontalMeterR.isVisible())
+        horizontalMeterR.setLevel(levelR);
+
+    float bands[Gui::SpectrumDisplay::numBands];
+
+    for (int stream = 0; stream < Dsp::SpectrumAnalyser::numStreams; stream++)
+    {
+        if (audioProcessor.getSpectrum(stream, bands))
+            spectrumDisplay.setBands(stream, bands);
+    }
+
+    // CPU statistics (min/mean/p99/max) a few times a second, only while shown
+    if (cpuLabel.isVisible() && ++cpuRefreshCount % 15 == 0)
+    {
+        const auto stats = audioProcessor.getBlockTimer().getStats();
+
+        cpuLabel.setText(juce::String(stats.min * 1.0e6, 0) + "/" + juce::String(stats.mean * 1.0e6, 0) + "/" + juce::String(stats.p99 * 1.0e6, 0) + "/" + juce::String(stats.max * 1.0e6, 0) + " us\n"
+                         + "load " + juce::String(stats.meanLoad, 1) + "% (max " + juce::String(stats.maxLoad, 1) + "%)",
+                         juce::dontSendNotification);
+    }
+
+    // the humanizer's formant bank has no single cutoff to draw
+    responseCurve.setVisible(!humanizerButton.getToggleState());
 
-    horizontalMeterL.repaint();
-    horizontalMeterR.repaint();
+    if (responseCurve.isVisible())
+        responseCurve.setParameters(audioProcessor.getCutoff(), (float) qualitySlider.getValue(),
+                                    juce::jmax(0, filterType.getSelectedId() - 1), audioProcessor.getSampleRate());
 }
 
 //==============================================================================
 void WahAudioProcessorEditor::paint(juce::Graphics& g)
 {
-    juce::Image background = juce::ImageCache::getFromMemory(BinaryData::metallo_png, BinaryData::metallo_pngSize);
-    g.drawImageAt(background, 220, 0);
+    g.drawImage(background, getLocalBounds().toFloat());
+}
+
+void WahAudioProcessorEditor::renderBackground()
+{
+    const auto scale = juce::Component::getApproximateScaleFactorForComponent(this);
+
+    background = juce::Image(juce::Image::RGB, juce::jmax(1, juce::roundToInt(getWidth() * scale)),
+                             juce::jmax(1, juce::roundToInt(getHeight() * scale)), true);
+
+    juce::Graphics g(background);
+    g.addTransform(juce::AffineTransform::scale(scale));
+
+    juce::Image metallo = juce::ImageCache::getFromMemory(BinaryData::metallo_png, BinaryData::metallo_pngSize);
+    g.drawImageAt(metallo, 220, 0);
 
     g.setFont(juce::Font("Arial", 40.0f, juce::Font::bold));
 
@@ -230,6 +473,8 @@ void WahAudioProcessorEditor::paint(juce::Graphics& g)
    
 void WahAudioProcessorEditor::resized()
 {
+    renderBackground();
+
     /*auto r = getLocalBounds();
     auto bottomSection = r.removeFromBottom(300);
 
@@ -270,8 +515,36 @@ void WahAudioProcessorEditor::resized()
      mode.setBounds(50, 20, 150, 50);
      filterType.setBounds(25, getHeight() * 0.15, 200, 70);
      
+     linkType.setBounds(15, 430, 150, 30);
+     detectorType.setBounds(175, 430, 150, 30);
+     lookaheadSlider.setBounds(415, 430, 170, 30);
+     lfoShape.setBounds(600, 430, 180, 30);
+     sweepMapping.setBounds(15, 475, 150, 30);
+     vowelPathEditor.setBounds(175, 475, 150, 30);
+     bandSplit.setBounds(15, 515, 150, 25);
+     crossoverSlider.setBounds(175, 515, 265, 25);
+     stereoMode.setBounds(450, 515, 140, 25);
+     stereoPhaseSlider.setBounds(585, 402, 200, 24);
+     cpuButton.setBounds(335, 475, 50, 30);
+     csvButton.setBounds(390, 475, 50, 30);
+     cpuLabel.setBounds(445, 470, 145, 40);
+    #if WAH_ENABLE_TRACING
+     traceButton.setBounds(710, 20, 70, 30);
+    #endif
+     shapeDrawer.setBounds(600, 465, 180, 55);
+
+     presetSearch.setBounds(260, 95, 235, 25);
+     presetList.setBounds(260, 125, 235, 25);
+     presetName.setBounds(260, 155, 160, 25);
+     presetSave.setBounds(425, 155, 70, 25);
+
+     spectrumDisplay.setBounds(510, 90, 280, 120);
+     responseCurve.setBounds(spectrumDisplay.getBounds());
+
      tapButton.setBounds(600, getHeight() / 2 - 130, 100, 100);
      interval_ms.setBounds(600-15, getHeight() / 2, 130, 50);
+     tapNote.setBounds(705, getHeight() / 2 - 115, 85, 25);
+     tapChannel.setBounds(705, getHeight() / 2 - 85, 85, 25);
 
      gainSlider.setBounds(getWidth() / 2 - 100, getHeight() / 2 - 130, 200, 200);
      // gainLabel.setBounds(800, 100, 100, 50);
@@ -324,6 +597,8 @@ void WahAudioProcessorEditor::firstVowelSelection()
         firstCurrentVowel = vowel[0];
         audioProcessor.set_firstVowel(0);
     }
+
+    vowelPathEditor.setText(juce::String::charToString(firstCurrentVowel) + juce::String::charToString(secondCurrentVowel), false);
 }
 
 void WahAudioProcessorEditor::secondVowelSelection()
@@ -358,6 +633,27 @@ void WahAudioProcessorEditor::secondVowelSelection()
         secondCurrentVowel = vowel[0];
         audioProcessor.set_secondVowel(0);
     }
+
+    vowelPathEditor.setText(juce::String::charToString(firstCurrentVowel) + juce::String::charToString(secondCurrentVowel), false);
+}
+
+void WahAudioProcessorEditor::vowelPathChanged()
+{
+    const auto text = vowelPathEditor.getText().toUpperCase();
+    int path[Dsp::VowelMorphTable::maxPathLength];
+    int numVowels = 0;
+
+    for (int i = 0; i < text.length() && numVowels < Dsp::VowelMorphTable::maxPathLength; i++)
+    {
+        for (int v = 0; v < 5; v++)
+        {
+            if (text[i] == vowel[v])
+                path[numVowels++] = v;
+        }
+    }
+
+    if (numVowels > 0)
+        audioProcessor.set_vowelPath(path, numVowels);
 }
 
 void WahAudioProcessorEditor::modeSelection()
@@ -379,21 +675,140 @@ void WahAudioProcessorEditor::modeSelection()
 
 void WahAudioProcessorEditor::tapClicked()
 {
-    if (!num_click) {
-        num_click++;
-        oldTime = juce::Time::getMillisecondCounterHiRes();
-    }
-    else if (num_click) {
-        newTime = juce::Time::getMillisecondCounterHiRes();
-        diff = newTime - oldTime;
-        diffBPM = (60 / diff) * 1000;
-        int diffPrint = (int)round(diffBPM);
-        oldTime = newTime;
-        std::string diff_str = std::to_string(diffPrint);
-        interval_ms.setText(diff_str, juce::dontSendNotification);
-        audioProcessor.set_rate(1.0/(diff/1000.0));
+    // the processor averages the taps; the new rate comes back through getRate
+    audioProcessor.tap();
+}
+
+void WahAudioProcessorEditor::syncControls()
+{
+    settingsGeneration = audioProcessor.getSettingsGeneration();
+    const auto settings = audioProcessor.getSettings();
+
+    depthSlider.setValue(settings.depth, juce::dontSendNotification);
+    qualitySlider.setValue(settings.quality, juce::dontSendNotification);
+    decaySlider.setValue(settings.decay, juce::dontSendNotification);
+    attackSlider.setValue(settings.attack, juce::dontSendNotification);
+    mixSlider.setValue(settings.mix, juce::dontSendNotification);
+    gainSlider.setValue(settings.gain, juce::dontSendNotification);
+    lookaheadSlider.setValue(settings.lookahead * 1000.0, juce::dontSendNotification);
+
+    filterType.setSelectedId(settings.filter + 1, juce::dontSendNotification);
+    linkType.setSelectedId(settings.link + 1, juce::dontSendNotification);
+    detectorType.setSelectedId(settings.detector + 1, juce::dontSendNotification);
+    lfoShape.setSelectedId(settings.lfoShape + 1, juce::dontSendNotification);
+    sweepMapping.setSelectedId(settings.mapping + 1, juce::dontSendNotification);
+    bandSplit.setSelectedId(settings.band + 1, juce::dontSendNotification);
+    crossoverSlider.setValue(settings.crossover, juce::dontSendNotification);
+    stereoMode.setSelectedId(settings.stereoMode + 1, juce::dontSendNotification);
+    stereoPhaseSlider.setValue(settings.stereoPhase, juce::dontSendNotification);
+    tapNote.setSelectedId(settings.tapNote + 1, juce::dontSendNotification);
+    tapChannel.setSelectedId(settings.tapChannel + 1, juce::dontSendNotification);
+
+    shapeDrawer.setPoints(settings.userShape, Dsp::Lfo::numUserPoints);
+    shapeDrawer.setVisible(settings.lfoShape == Dsp::Lfo::user);
+
+    humanizerButton.setToggleState(settings.humanizer, juce::dontSendNotification);
+
+    currentMode = settings.mode;
+    mode.setToggleState(currentMode == 0, juce::dontSendNotification);
+    mode.setButtonText(currentMode == 0 ? "TEMPO" : "DYNAMIC");
+
+    juce::String path;
+
+    for (int i = 0; i < settings.vowelPathLength; i++)
+        path += juce::String::charToString(vowel[settings.vowelPath[i]]);
+
+    vowelPathEditor.setText(path, false);
+    showVowel(firstVowel, settings.vowelPath[0]);
+    showVowel(secondVowel, settings.vowelPath[juce::jmin(1, settings.vowelPathLength - 1)]);
+    firstCurrentVowel = vowel[settings.vowelPath[0]];
+    secondCurrentVowel = vowel[settings.vowelPath[juce::jmin(1, settings.vowelPathLength - 1)]];
+}
+
+void WahAudioProcessorEditor::showVowel(juce::TextButton& button, int vowelIndex)
+{
+    const juce::Colour colours[] = { juce::Colours::red.darker(0.2f), juce::Colours::green, juce::Colours::pink,
+                                     juce::Colours::yellow, juce::Colours::blue };
+
+    button.setButtonText(juce::String::charToString(vowel[vowelIndex]));
+    button.setColour(juce::TextButton::buttonOnColourId, colours[vowelIndex]);
+}
+
+void WahAudioProcessorEditor::updatePresetList()
+{
+    presetResults = presetLibrary.search(presetSearch.getText(), maxPresetResults);
+    presetList.clear(juce::dontSendNotification);
+
+    for (int i = 0; i < presetResults.size(); i++)
+        presetList.addItem(presetLibrary.getName(presetResults[i]), i + 1);
+}
+
+// "Name #tag #tag" saves the current settings under Name, tagged
+void WahAudioProcessorEditor::savePreset()
+{
+    juce::StringArray words;
+    words.addTokens(presetName.getText(), true);
+    words.removeEmptyStrings();
+
+    juce::StringArray name, tags;
+
+    for (const auto& word : words)
+    {
+        if (word.startsWithChar('#'))
+            tags.add(word.substring(1));
+        else
+            name.add(word);
     }
+
+    if (name.isEmpty())
+        return;
+
+    if (presetLibrary.add(name.joinIntoString(" "), tags.joinIntoString(" "), audioProcessor.getSettings()))
+    {
+        presetName.clear();
+        updatePresetList();
+    }
+}
+
+void WahAudioProcessorEditor::cpuButtonToggle()
+{
+    cpuLabel.setVisible(cpuButton.getToggleState());
+    cpuRefreshCount = 0;
+}
+
+void WahAudioProcessorEditor::csvClicked()
+{
+    fileChooser = std::make_unique<juce::FileChooser>("Save block timings",
+                                                     juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile("wah_block_times.csv"),
+                                                     "*.csv");
+
+    fileChooser->launchAsync(juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::canSelectFiles,
+                            [this](const juce::FileChooser& chooser)
+                            {
+                                const auto file = chooser.getResult();
+
+                                if (file != juce::File())
+                                    audioProcessor.getBlockTimer().writeCsv(file);
+                            });
+}
+
+#if WAH_ENABLE_TRACING
+void WahAudioProcessorEditor::traceClicked()
+{
+    fileChooser = std::make_unique<juce::FileChooser>("Save trace",
+                                                     juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile("wah_trace.json"),
+                                                     "*.json");
+
+    fileChooser->launchAsync(juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::canSelectFiles,
+                            [](const juce::FileChooser& chooser)
+                            {
+                                const auto file = chooser.getResult();
+
+                                if (file != juce::File())
+                                    Diagnostics::Trace::writeChromeJson(file);
+                            });
 }
+#endif
 
 void WahAudioProcessorEditor::sliderValueChanged(juce::Slider* slider)
 {
@@ -422,11 +837,67 @@ void WahAudioProcessorEditor::sliderValueChanged(juce::Slider* slider)
     {
         audioProcessor.set_gain(gainSlider.getValue());
     }
+    else if (slider == &lookaheadSlider)
+    {
+        audioProcessor.set_lookahead(lookaheadSlider.getValue() / 1000.0);
+    }
+    else if (slider == &crossoverSlider)
+    {
+        audioProcessor.set_crossover(crossoverSlider.getValue());
+    }
+    else if (slider == &stereoPhaseSlider)
+    {
+        audioProcessor.set_stereoPhase(stereoPhaseSlider.getValue());
+    }
 }
 
 void WahAudioProcessorEditor::comboBoxChanged(juce::ComboBox* comboBox)
 {
-    if (comboBox->getText() == "LowPass")
+    if (comboBox == &presetList)
+    {
+        if (presetList.getSelectedId() == 0)
+            return;
+
+        const int index = presetResults[presetList.getSelectedId() - 1];
+        State::Settings settings;
+
+        if (presetLibrary.load(index, settings))
+            audioProcessor.loadSettings(settings);
+    }
+    else if (comboBox == &linkType)
+    {
+        audioProcessor.set_link(linkType.getSelectedId() - 1);
+    }
+    else if (comboBox == &detectorType)
+    {
+        audioProcessor.set_detector(detectorType.getSelectedId() - 1);
+    }
+    else if (comboBox == &sweepMapping)
+    {
+        audioProcessor.set_mapping(sweepMapping.getSelectedId() - 1);
+    }
+    else if (comboBox == &bandSplit)
+    {
+        audioProcessor.set_band(bandSplit.getSelectedId() - 1);
+    }
+    else if (comboBox == &stereoMode)
+    {
+        audioProcessor.set_stereoMode(stereoMode.getSelectedId() - 1);
+    }
+    else if (comboBox == &tapNote)
+    {
+        audioProcessor.set_tapNote(tapNote.getSelectedId() - 1);
+    }
+    else if (comboBox == &tapChannel)
+    {
+        audioProcessor.set_tapChannel(tapChannel.getSelectedId() - 1);
+    }
+    else if (comboBox == &lfoShape)
+    {
+        audioProcessor.set_lfoShape(lfoShape.getSelectedId() - 1);
+        shapeDrawer.setVisible(lfoShape.getSelectedId() - 1 == Dsp::Lfo::user);
+    }
+    else if (comboBox->getText() == "LowPass")
     {
         audioProcessor.set_filter(0);
     }
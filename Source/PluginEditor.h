@@ -12,6 +12,10 @@
 #include "PluginProcessor.h"
 #include "Components/HorizontalMeter.h"
 #include "Components/VerticalGradientMeter.h"
+#include "Components/ShapeDrawer.h"
+#include "Components/SpectrumDisplay.h"
+#include "Components/ResponseCurve.h"
+#include "State/PresetLibrary.h"
 
 //==============================================================================
 /**
@@ -73,13 +77,20 @@ public:
 
     //==============================================================================
     void timerCallback() override;
+    void refresh();
     void paint (juce::Graphics&) override;
     void resized() override;
     void humanizerButtonToggle();
     void firstVowelSelection();
     void secondVowelSelection();
+    void vowelPathChanged();
     void modeSelection();
     void tapClicked();
+    void cpuButtonToggle();
+    void csvClicked();
+   #if WAH_ENABLE_TRACING
+    void traceClicked();
+   #endif
     //void colouredVowels();
 
 private:
@@ -96,6 +107,9 @@ private:
     juce::Slider attackSlider;
     juce::Slider mixSlider;
     juce::Slider gainSlider;
+    juce::Slider lookaheadSlider;
+    juce::Slider crossoverSlider;
+    juce::Slider stereoPhaseSlider;
 
     juce::Label depthLabel;
     juce::Label qualityLabel;
@@ -105,29 +119,76 @@ private:
     juce::Label gainLabel;
     juce::Label interval_ms;
     juce::Label humanizerLabel;
+    juce::Label lookaheadLabel;
+    juce::Label cpuLabel;
     
     juce::ComboBox filterType;
+    juce::ComboBox linkType;
+    juce::ComboBox detectorType;
+    juce::ComboBox lfoShape;
+    juce::ComboBox sweepMapping;
+    juce::ComboBox bandSplit;
+    juce::ComboBox stereoMode;
+    juce::ComboBox tapNote;
+    juce::ComboBox tapChannel;
+
+    juce::TextEditor vowelPathEditor;
     
     juce::ImageButton humanizerButton;
     juce::TextButton firstVowel;
     juce::TextButton secondVowel;
     juce::TextButton mode;
     juce::TextButton tapButton;
+    juce::TextButton cpuButton;
+    juce::TextButton csvButton;
+   #if WAH_ENABLE_TRACING
+    juce::TextButton traceButton;
+   #endif
+
+    std::unique_ptr<juce::FileChooser> fileChooser;
+    int cpuRefreshCount = 0;
 
     Gui::VerticalGradientMeter verticalGradientMeterL, verticalGradientMeterR;
     Gui::HorizontalMeter horizontalMeterL, horizontalMeterR;
+    Gui::ShapeDrawer shapeDrawer;
+    Gui::SpectrumDisplay spectrumDisplay;
+    Gui::ResponseCurve responseCurve;
 
     char vowel[5] = { 'A', 'E', 'I', 'O', 'U' };
     char firstCurrentVowel = 'A';
     char secondCurrentVowel = 'A';
+    void showVowel(juce::TextButton& button, int vowelIndex);
     int currentMode = 0;
 
-    double newTime;
-    double oldTime;
-    double diff;
-    double diffBPM;
-    int num_click = 0;
-    
+    // One refresh driver for the whole editor, synced to the display where available
+   #if JUCE_MAJOR_VERSION >= 7
+    juce::VBlankAttachment vBlankAttachment { this, [this]() { refresh(); } };
+   #endif
+
+    // Static background (image, panels, title), rendered on resize only
+    juce::Image background;
+    void renderBackground();
+
+    // Pulls the processor's settings into the controls whenever they were
+    // replaced as a whole (session load, program change)
+    int settingsGeneration = -1;
+    void syncControls();
+
+    // The BPM readout follows the rate on its own: taps and MIDI clock
+    // change it without replacing the settings
+    int displayedBpm = -1;
+
+    // User preset browser over the memory-mapped library
+    static constexpr int maxPresetResults = 500;
+    State::PresetLibrary presetLibrary { State::PresetLibrary::getDefaultFile() };
+    juce::TextEditor presetSearch;
+    juce::ComboBox presetList;
+    juce::TextEditor presetName;
+    juce::TextButton presetSave;
+    juce::Array<int> presetResults;
+    void updatePresetList();
+    void savePreset();
+
     void sliderValueChanged(juce::Slider* slider) override;
     void comboBoxChanged(juce::ComboBox* comboBox) override;
     
@@ -22,6 +22,21 @@ WahAudioProcessor::WahAudioProcessor()
                        )
 #endif
 {
+    addParameter(bypass = new juce::AudioParameterBool("bypass", "Bypass", false));
+    addParameter(tapParameter = new juce::AudioParameterBool("tap", "Tap Tempo", false));
+    
+    minFreq = 350.0f;
+    setSettings(State::Settings());
+    
+    for (int i = 0; i < State::FactoryPrograms::getNumPrograms(); i++)
+    {
+        auto* snapshot = programSnapshots.add(new Snapshot());
+        snapshot->settings = State::FactoryPrograms::getProgram(i).settings;
+        snapshot->sweep.allocate(Dsp::SweepTable::tableSize + 1, true);
+    }
+    
+    for (auto& snapshot : presetSnapshots)
+        snapshot.sweep.allocate(Dsp::SweepTable::tableSize + 1, true);
 }
 
 WahAudioProcessor::~WahAudioProcessor()
@@ -61,33 +76,65 @@ bool WahAudioProcessor::isMidiEffect() const
    #endif
 }
 
+// The slowest resonance left ringing after the input stops: a state variable
+// filter with damping q at angular frequency w decays with time constant
+// 2 / (q w), reported as the time to fall by 60 dB, plus the lookahead.
 double WahAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    auto t60 = [](double q, double f)
+    {
+        return std::log(1000.0) * 2.0 / (juce::jmax(0.01, q) * juce::MathConstants<double>::twoPi * f);
+    };
+    
+    // the sweep's lowest cutoff rings longest
+    double tail = t60(Q, minFreq);
+    
+    if (humanizerOn)
+    {
+        for (int i = 0; i < vowelPathLength; i++)
+        {
+            for (int k = 0; k < Dsp::FormantBank::numFormants; k++)
+            {
+                const auto& formant = Dsp::FormantBank::getFormant(vowelPath[i], k);
+                tail = juce::jmax(tail, t60(Dsp::FormantBank::getDamping(formant.freq, formant.bandwidth, Q), formant.freq));
+            }
+        }
+    }
+    
+    return tail + lookahead;
 }
 
 int WahAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    return State::FactoryPrograms::getNumPrograms();
 }
 
 int WahAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return currentProgram;
 }
 
+// Any thread: applied by the audio thread at the start of the next block
 void WahAudioProcessor::setCurrentProgram (int index)
 {
+    if (!juce::isPositiveAndBelow(index, getNumPrograms()))
+        return;
+    
+    currentProgram = index;
+    pendingSnapshot.store(programSnapshots[index]);
 }
 
 const juce::String WahAudioProcessor::getProgramName (int index)
 {
-    return {};
+    if (!juce::isPositiveAndBelow(index, getNumPrograms()))
+        return {};
+    
+    return State::FactoryPrograms::getProgram(index).name;
 }
 
 void WahAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
+    // factory programs keep their names
 }
 
 //==============================================================================
@@ -95,33 +142,57 @@ void WahAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {   
     auto totalNumInputChannels = getTotalNumInputChannels();
     
+    detectors.clear();
+    
 	for (int i = 0; i < getTotalNumInputChannels(); i++)
     {
-        env.add(0.0f);
-        yh.add(0.0f);
-        yb.add(0.0f);
-        yl.add(0.0f);
-        yh1.add(0.0f);
-        yb1.add(0.0f);
-        yl1.add(0.0f);
-        yh2.add(0.0f);
-        yb2.add(0.0f);
-        yl2.add(0.0f);
-        sample.add(0);
+        detectors.add(new Dsp::EnvelopeDetector());
+        detectors.getLast()->prepare(sampleRate);
     }
     
-    minFreq = 350.0f;
-    depth = 1700.0f;
+    // kept across prepares, their buffers only grow
+    delayLines.removeLast(juce::jmax(0, delayLines.size() - totalNumInputChannels));
+    
+    while (delayLines.size() < totalNumInputChannels)
+        delayLines.add(new Dsp::DelayLine());
+    
+    for (auto* d : delayLines)
+        d->prepare(juce::roundToInt(maxLookahead * sampleRate));
+    
+    lfo.prepare(sampleRate);
+    tapTempo.prepare(sampleRate);
+    midiClock.prepare(sampleRate);
+    editorTapsSeen = editorTaps.load();
+    lfoBuffer.setSize(juce::jmax(1, totalNumInputChannels), samplesPerBlock);
+    lfoOffsets.allocate((size_t) juce::jmax(1, totalNumInputChannels), true);
+    envBuffer.setSize(juce::jmax(1, totalNumInputChannels), samplesPerBlock);
+    sidechainBuffer.setSize(2, samplesPerBlock);
+    linkedDetector.prepare(sampleRate);
+    
+    for (auto& engine : engines)
+        engine.prepare(sampleRate, totalNumInputChannels, samplesPerBlock);
+    
+    crossfadeBuffer.setSize(1, samplesPerBlock);
+    bypassBuffer.setSize(totalNumInputChannels + 1, samplesPerBlock);
+    processedGain.reset(sampleRate, bypassFadeTime);
+    processedGain.setCurrentAndTargetValue(bypass->get() ? 0.0f : 1.0f);
+    fullyBypassed = bypass->get();
+    silentSamples = 0;
+    sleeping = false;
+    crossfadeLength = juce::jmax(1, juce::roundToInt(crossfadeTime * sampleRate));
+    crossfadeRemaining = 0;
+    updateLatency();
+    
+    for (auto* snapshot : programSnapshots)
+        Dsp::SweepTable::fill(snapshot->sweep.get(), minFreq, minFreq + snapshot->settings.depth, snapshot->settings.mapping, sampleRate);
+    
+    applyPendingSnapshot();
+    
     maxFreq = minFreq + depth;
-    freq = (minFreq + maxFreq) / 2;
-    Q = 0.1;
-    rate = 1.0;
-    G = 1.0;
-    wet = 0.5;
-    dry = 0.5;
-    firstVowel = 0;
-    secondVowel = 0;
-    humanizerOn = false;
+    
+    updateSweepTable();
+    vowelTable.prepare(vowelPath, vowelPathLength, Q, sampleRate);
+    analyser.prepare(sampleRate);
 }
 
 void WahAudioProcessor::releaseResources()
@@ -158,25 +229,99 @@ bool WahAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) cons
 
 void WahAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    Diagnostics::BlockTimer::ScopedMeasurement measurement (blockTimer, buffer.getNumSamples(), getSampleRate());
+    WAH_TRACE_SCOPE("processBlock");
     juce::ScopedNoDenormals noDenormals;
     
-    rmsLevelLeft.skip(buffer.getNumSamples());
-    rmsLevelRight.skip(buffer.getNumSamples());
-
+    const auto blockStart = sampleClock;
+    sampleClock += buffer.getNumSamples();
+    
+    for (const auto metadata : midiMessages)
     {
-        const auto value = juce::Decibels::gainToDecibels(buffer.getRMSLevel(0, 0, buffer.getNumSamples()));
-        if (value < rmsLevelLeft.getCurrentValue())
-            rmsLevelLeft.setTargetValue(value);
-        else
-            rmsLevelLeft.setCurrentAndTargetValue(value);
+        const auto message = metadata.getMessage();
+        
+        if (message.isProgramChange())
+            setCurrentProgram(message.getProgramChangeNumber());
     }
-
+    
+    applyPendingSnapshot();
+    
+    // taps after a program change, so they win over its rate
     {
-        const auto value = juce::Decibels::gainToDecibels(buffer.getRMSLevel(1, 0, buffer.getNumSamples()));
-        if (value < rmsLevelRight.getCurrentValue())
-            rmsLevelRight.setTargetValue(value);
-        else
-            rmsLevelRight.setCurrentAndTargetValue(value);
+        // the editor's tap happened before this block, by its wall clock age
+        const int taps = editorTaps.load();
+        
+        if (taps != editorTapsSeen)
+        {
+            editorTapsSeen = taps;
+            const double age = juce::Time::getMillisecondCounterHiRes() - editorTapTime.load();
+            handleTap(blockStart - (juce::int64) (juce::jmax(0.0, age) * 0.001 * getSampleRate()), blockStart);
+        }
+        
+        // parameter changes only arrive per block
+        const bool tapDown = tapParameter->get();
+        
+        if (tapDown && !tapParameterDown)
+            handleTap(blockStart, blockStart);
+        
+        tapParameterDown = tapDown;
+        
+        for (const auto metadata : midiMessages)
+        {
+            const auto message = metadata.getMessage();
+            const auto time = blockStart + metadata.samplePosition;
+            
+            if (message.isNoteOn())
+            {
+                if (message.getNoteNumber() == tapNote && (tapChannel == 0 || message.isForChannel(tapChannel)))
+                    handleTap(time, blockStart);
+            }
+            else if (message.isMidiClock())
+                midiClock.tick(time);
+            else if (message.isMidiStart())
+                midiClock.start();
+            else if (message.isMidiContinue())
+                midiClock.resume();
+            else if (message.isMidiStop())
+                midiClock.stop();
+            else if (message.isSongPositionPointer())
+                midiClock.setSongPosition(message.getSongPositionPointerMidiBeat());
+        }
+    }
+    
+    // MIDI clock wins over taps while it's coming in
+    if (midiClock.isLocked(blockStart))
+    {
+        // the editor's BPM readout picks this up through getRate
+        rate = (float) midiClock.getRate();
+        currentRate.store(rate);
+        lfo.setRate(rate);
+        
+        if (midiClock.isRunning())
+            lfo.setPhase(midiClock.getPhase(blockStart));
+    }
+    
+    {
+        WAH_TRACE_SCOPE("metering");
+        
+        rmsLevelLeft.skip(buffer.getNumSamples());
+        rmsLevelRight.skip(buffer.getNumSamples());
+
+        {
+            const auto value = juce::Decibels::gainToDecibels(buffer.getRMSLevel(0, 0, buffer.getNumSamples()));
+            if (value < rmsLevelLeft.getCurrentValue())
+                rmsLevelLeft.setTargetValue(value);
+            else
+                rmsLevelLeft.setCurrentAndTargetValue(value);
+        }
+
+        {
+            const auto value = juce::Decibels::gainToDecibels(buffer.getRMSLevel(1, 0, buffer.getNumSamples()));
+            if (value < rmsLevelRight.getCurrentValue())
+                rmsLevelRight.setTargetValue(value);
+            else
+                rmsLevelRight.setCurrentAndTargetValue(value);
+        }
     }
     
     auto totalNumInputChannels  = getTotalNumInputChannels();
@@ -187,108 +332,308 @@ void WahAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::Mi
     
     int numSamples = buffer.getNumSamples();
     
-    float alpha;
-    float alpha_atk = exp(-1.0f / (atk * getSampleRate()));
-    float alpha_rel = exp(-1.0f / (rel * getSampleRate()));
+    // bypass: fade out, then only keep the audio path's latency
+    processedGain.setTargetValue(bypass->get() ? 0.0f : 1.0f);
+    
+    if (!processedGain.isSmoothing() && processedGain.getTargetValue() == 0.0f)
+    {
+        delayAudioPath(buffer, totalNumInputChannels);
+        fullyBypassed = true;
+        return;
+    }
+    
+    // back from bypass: the fade in hides the restart from reset state
+    if (fullyBypassed)
+    {
+        for (auto& e : engines)
+            e.reset();
+        
+        for (auto* d : detectors)
+            d->reset();
+        
+        linkedDetector.reset();
+        fullyBypassed = false;
+    }
+    
+    const bool bypassFading = processedGain.isSmoothing();
+    
+    // silence: everything the output could still depend on has died away
+    {
+        bool inputSilent = true;
+        
+        for (int channel = 0; channel < totalNumInputChannels && inputSilent; channel++)
+            inputSilent = buffer.getMagnitude(channel, 0, numSamples) < silenceThreshold;
+        
+        silentSamples = inputSilent ? silentSamples + numSamples : 0;
+        
+        const bool canSleep = inputSilent
+                           && silentSamples >= numSamples + getLatencySamples()
+                           && crossfadeRemaining == 0
+                           && !bypassFading
+                           && engines[activeEngine].getStateMagnitude() < silenceThreshold;
+        
+        if (canSleep)
+        {
+            // drop the residue so waking up starts clean
+            if (!sleeping)
+            {
+                for (auto& e : engines)
+                    e.reset();
+                
+                for (auto* d : detectors)
+                    d->reset();
+                
+                for (auto* d : delayLines)
+                    d->reset();
+                
+                linkedDetector.reset();
+                sleeping = true;
+            }
+            
+            // the tempo sweep keeps its phase
+            lfo.setRate(rate);
+            lfo.skip(numSamples);
+            
+            for (int channel = 0; channel < totalNumInputChannels; channel++)
+                buffer.clear(channel, 0, numSamples);
+            
+            return;
+        }
+        
+        sleeping = false;
+    }
+    
+    if (bypassFading && (bypassBuffer.getNumSamples() < numSamples || bypassBuffer.getNumChannels() < totalNumInputChannels + 1))
+        bypassBuffer.setSize(totalNumInputChannels + 1, numSamples, false, false, true);
+    
+    {
+        WAH_TRACE_SCOPE("analyser input");
+        analyser.push(Dsp::SpectrumAnalyser::input, buffer, totalNumInputChannels, numSamples);
+    }
+    
+    // engine parameters for this block; a switch the filter state can't
+    // follow starts a crossfade into the idle engine, reset
+    {
+        Dsp::WahEngine::Parameters target;
+        target.mode = mode;
+        target.filter = filter;
+        target.humanizer = humanizerOn;
+        target.band = band;
+        target.crossover = crossover;
+        target.Q = Q;
+        target.gain = G;
+        target.wet = wet;
+        target.dry = dry;
+        
+        const bool requested = crossfadeRequested.exchange(false);
+        
+        if ((requested || engines[activeEngine].parameters.needsCrossfade(target)) && crossfadeRemaining == 0)
+        {
+            activeEngine = 1 - activeEngine;
+            engines[activeEngine].reset();
+            crossfadeRemaining = crossfadeLength;
+        }
+        
+        // a switch during a crossfade goes to the incoming engine directly
+        engines[activeEngine].parameters = target;
+    }
+    
+    auto& engine = engines[activeEngine];
+    auto& fadingEngine = engines[1 - activeEngine];
+    const bool crossfading = crossfadeRemaining > 0;
     
-    float wet_now = wet;
-    float dry_now = dry;
+    // the sweep sources either running engine needs
+    const bool tempoNeeded = engine.parameters.mode == 0 || (crossfading && fadingEngine.parameters.mode == 0);
+    const bool dynamicNeeded = engine.parameters.mode == 1 || (crossfading && fadingEngine.parameters.mode == 1);
     
     maxFreq = minFreq + depth;
     
-    for (int channel = 0; channel < totalNumInputChannels; channel++)
+    // sweep oscillator, rendered once, or once per channel at its offset
+    const bool lfoPerChannel = stereoPhase > 0.0f && totalNumInputChannels > 1;
+    
+    if (tempoNeeded)
     {
-        const float* channelInData = buffer.getReadPointer(channel);
-        float* channelOutData = buffer.getWritePointer (channel);
+        WAH_TRACE_SCOPE("lfo");
         
-        float newEnv;
-        float normalizedFreq, F;
+        if (lfoBuffer.getNumSamples() < numSamples)
+            lfoBuffer.setSize(lfoBuffer.getNumChannels(), numSamples);
         
-        for (int i = 0; i < numSamples; i++)
+        lfo.setShape(lfoShape);
+        lfo.setRate(rate);
+        
+        if (lfoPerChannel)
         {
-            const float x = channelInData[i];
-            const float abs_x = fabs(x);
+            const double cycles = stereoPhase / 360.0;
             
-            // level detector
-            if (abs_x > env[channel])
-                alpha = alpha_atk;
-            else
-                alpha = alpha_rel;
+            for (int channel = 0; channel < totalNumInputChannels; channel++)
+            {
+                if (stereoMode == 0)
+                    lfoOffsets[channel] = channel > 0 ? -cycles : 0.0;
+                else
+                    lfoOffsets[channel] = cycles * (0.5 - (double) channel / (totalNumInputChannels - 1));
+            }
+            
+            lfo.process(lfoBuffer.getArrayOfWritePointers(), lfoOffsets.get(), totalNumInputChannels, numSamples);
+        }
+        else
+        {
+            lfo.process(lfoBuffer.getWritePointer(0), numSamples);
+        }
+    }
+    
+    const Dsp::SweepTable::Coefficient* sweep = programSweep.load();
+    
+    if (sweep == nullptr)
+        sweep = sweepTable.acquire();
+    
+    // stereo-linked detector: one envelope from the max (or mean) of all channels,
+    // one set of coefficients per sample broadcast to every channel
+    const bool linkedNow = (link != 0) && (totalNumInputChannels > 1);
+    
+    // level detector, block-wise into envBuffer
+    if (dynamicNeeded)
+    {
+        WAH_TRACE_SCOPE("detector");
+        
+        if (envBuffer.getNumSamples() < numSamples)
+            envBuffer.setSize(envBuffer.getNumChannels(), numSamples);
+        
+        if (linkedNow)
+        {
+            if (sidechainBuffer.getNumSamples() < numSamples)
+                sidechainBuffer.setSize(2, numSamples, false, false, true);
+            
+            float* sidechain = sidechainBuffer.getWritePointer(0);
+            float* channelAbs = sidechainBuffer.getWritePointer(1);
             
-            newEnv = alpha * env[channel] + (1.0f - alpha) * abs_x;
-			env.set(channel, newEnv);
+            juce::FloatVectorOperations::abs(sidechain, buffer.getReadPointer(0), numSamples);
             
-			if(humanizerOn)
+            for (int channel = 1; channel < totalNumInputChannels; channel++)
             {
-                float firstVowelFirstFormant = formants[firstVowel][0];
-                float firstVowelSecondFormant = formants[firstVowel][1];
-                float secondVowelFirstFormant = formants[secondVowel][0];
-                float secondVowelSecondFormant = formants[secondVowel][1];
-                
-                float freq1, freq2;
-                
-                // tempo
-			    if (mode == 0)
-                {
-                    freq1 = ((firstVowelFirstFormant + secondVowelFirstFormant) / 2) + ((secondVowelFirstFormant - firstVowelFirstFormant) / 2) * sin (2 * M_PI * rate * sample[channel] / SAMPLE_RATE);
-                    freq2 = ((firstVowelSecondFormant + secondVowelSecondFormant) / 2) + ((secondVowelSecondFormant - firstVowelSecondFormant) / 2) * sin (2 * M_PI * rate * sample[channel] / SAMPLE_RATE);
-                }
-			    // dynamic
-			    else if (mode == 1)
-                {
-                    freq1 = firstVowelFirstFormant + (secondVowelFirstFormant - firstVowelFirstFormant) * newEnv;
-                    freq2 = firstVowelSecondFormant + (secondVowelSecondFormant - firstVowelSecondFormant) * newEnv;
-                }
+                juce::FloatVectorOperations::abs(channelAbs, buffer.getReadPointer(channel), numSamples);
                 
-                // update F
-                float F1 = 2 * sin(M_PI * freq1 / SAMPLE_RATE);
-                float F2 = 2 * sin(M_PI * freq2 / SAMPLE_RATE);
-			    
-			    // state variable filter
-                yh1.set(channel, x - yl1[channel] - Q * yb1[channel]);
-                yb1.set(channel, F1 * yh1[channel] + yb1[channel]);
-                yl1.set(channel, F1 * yb1[channel] + yl1[channel]);
-                
-                yh2.set(channel, x - yl2[channel] - Q * yb2[channel]);
-                yb2.set(channel, F2 * yh2[channel] + yb2[channel]);
-                yl2.set(channel, F2 * yb2[channel] + yl2[channel]);
-                
-                float ylHumanizer = yl1[channel]/2.0 + yl2[channel]/2.0;
-                float ybHumanizer = yb1[channel]/2.0 + yb2[channel]/2.0;
-                float yhHumanizer = yh1[channel]/2.0 + yh2[channel]/2.0;
-                
-                // output
-                float yHumanizer[] = { ylHumanizer, ybHumanizer, yhHumanizer };
-                channelOutData[i] = G * (dry_now * x + wet_now * yHumanizer[filter]);
+                if (link == 1)
+                    juce::FloatVectorOperations::max(sidechain, sidechain, channelAbs, numSamples);
+                else
+                    juce::FloatVectorOperations::add(sidechain, channelAbs, numSamples);
             }
-            else
+            
+            if (link == 2)
+                juce::FloatVectorOperations::multiply(sidechain, 1.0f / totalNumInputChannels, numSamples);
+            
+            linkedDetector.setType(detector);
+            linkedDetector.setAttackRelease(atk, rel);
+            linkedDetector.process(sidechain, envBuffer.getWritePointer(0), numSamples);
+        }
+        else
+        {
+            for (int channel = 0; channel < totalNumInputChannels; channel++)
             {
-                // tempo
-			    if (mode == 0)
-			        freq = ((minFreq + maxFreq) / 2) + ((maxFreq - minFreq) / 2) * sin (2 * M_PI * rate * sample[channel] / SAMPLE_RATE);
-			    // dynamic
-			    else if (mode == 1)
-			        freq = minFreq + (maxFreq - minFreq) * newEnv;
+                detectors[channel]->setType(detector);
+                detectors[channel]->setAttackRelease(atk, rel);
+                detectors[channel]->process(buffer.getReadPointer(channel), envBuffer.getWritePointer(channel), numSamples);
+            }
+        }
+    }
+    
+    // lookahead: delay the audio path after the detector has seen the input
+    {
+        WAH_TRACE_SCOPE("lookahead");
+        delayAudioPath(buffer, totalNumInputChannels);
+    }
+    
+    if (bypassFading)
+    {
+        for (int channel = 0; channel < totalNumInputChannels; channel++)
+            bypassBuffer.copyFrom(channel, 0, buffer, channel, 0, numSamples);
+    }
+    
+    // humanizer vowel morph coefficients, one entry per morph position
+    const auto vowelMorph = vowelTable.acquire();
+    
+    if (crossfading && crossfadeBuffer.getNumSamples() < numSamples)
+        crossfadeBuffer.setSize(1, numSamples, false, false, true);
+    
+    for (int channel = 0; channel < totalNumInputChannels; channel++)
+    {
+        float* channelData = buffer.getWritePointer (channel);
+        const Dsp::EngineSample* envData = envBuffer.getReadPointer(linkedNow ? 0 : channel);
+        const Dsp::EngineSample* lfoData = lfoBuffer.getReadPointer(lfoPerChannel ? channel : 0);
+        
+        auto positionsFor = [&](const Dsp::WahEngine& e) { return e.parameters.mode == 0 ? lfoData : envData; };
+        auto shareFor = [&](const Dsp::WahEngine& e) { return linkedNow && channel > 0 && e.parameters.mode == 1; };
+        
+        // the outgoing engine reads the input before the incoming one overwrites it
+        if (crossfading)
+            fadingEngine.process(channel, channelData, crossfadeBuffer.getWritePointer(0), numSamples,
+                                 positionsFor(fadingEngine), sweep, vowelMorph, shareFor(fadingEngine));
+        
+        engine.process(channel, channelData, channelData, numSamples, positionsFor(engine), sweep, vowelMorph, shareFor(engine));
+        
+        if (crossfading)
+        {
+            WAH_TRACE_SCOPE("crossfade");
             
-			    // update F
-			    F = 2 * sin(M_PI * freq / SAMPLE_RATE);
-			    
-			    // state variable filter
-                yh.set(channel, x - yl[channel] - Q * yb[channel]);
-                yb.set(channel, F * yh[channel] + yb[channel]);
-                yl.set(channel, F * yb[channel] + yl[channel]);
-                
-                // output
-                float y[] = { yl[channel], yb[channel], yh[channel] };
-                channelOutData[i] = G * (dry_now * x + wet_now * y[filter]);
+            const float* fadingData = crossfadeBuffer.getReadPointer(0);
+            const int done = crossfadeLength - crossfadeRemaining;
+            
+            for (int i = 0; i < numSamples; i++)
+            {
+                const float g = juce::jmin(1.0f, (float) (done + i) / crossfadeLength);
+                channelData[i] = fadingData[i] + g * (channelData[i] - fadingData[i]);
             }
+        }
+    }
+    
+    if (crossfading)
+        crossfadeRemaining = juce::jmax(0, crossfadeRemaining - numSamples);
+    
+    if (bypassFading)
+    {
+        WAH_TRACE_SCOPE("bypass fade");
+        
+        float* ramp = bypassBuffer.getWritePointer(totalNumInputChannels);
+        
+        for (int i = 0; i < numSamples; i++)
+            ramp[i] = processedGain.getNextValue();
+        
+        for (int channel = 0; channel < totalNumInputChannels; channel++)
+        {
+            float* channelData = buffer.getWritePointer(channel);
+            const float* dryData = bypassBuffer.getReadPointer(channel);
             
-            sample.set(channel, sample[channel]+1);
+            for (int i = 0; i < numSamples; i++)
+                channelData[i] = dryData[i] + ramp[i] * (channelData[i] - dryData[i]);
         }
     }
+    
+    // publish the cutoff the sweep ended the block on
+    if (!engine.parameters.humanizer && numSamples > 0)
+        currentCutoff.store(asin(juce::jlimit(-1.0f, 1.0f, 0.5f * engine.getLastCoefficient())) * (float) getSampleRate() / juce::MathConstants<float>::pi);
+    
+    {
+        WAH_TRACE_SCOPE("analyser output");
+        analyser.push(Dsp::SpectrumAnalyser::output, buffer, totalNumInputChannels, numSamples);
+    }
 }
 
 //==============================================================================
+// Hosts that bypass without the parameter: same as fully bypassed
+void WahAudioProcessor::processBlockBypassed (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+{
+    for (auto i = getTotalNumInputChannels(); i < getTotalNumOutputChannels(); ++i)
+        buffer.clear (i, 0, buffer.getNumSamples());
+    
+    delayAudioPath(buffer, getTotalNumInputChannels());
+    processedGain.setCurrentAndTargetValue(0.0f);
+    fullyBypassed = true;
+}
+
+juce::AudioProcessorParameter* WahAudioProcessor::getBypassParameter() const
+{
+    return bypass;
+}
+
 bool WahAudioProcessor::hasEditor() const
 {
     return true; // (change this to false if you choose to not supply an editor)
@@ -302,15 +647,19 @@ juce::AudioProcessorEditor* WahAudioProcessor::createEditor()
 //==============================================================================
 void WahAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
+    State::Format::write(getSettings(), destData);
 }
 
 void WahAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
+    State::Settings settings;
+    
+    if (State::Format::read(data, sizeInBytes, settings))
+    {
+        // the restored state wins over a program change still in flight
+        pendingSnapshot.store(nullptr);
+        setSettings(settings);
+    }
 }
 
 float WahAudioProcessor::getRmsValue(const int channel) const
@@ -323,6 +672,26 @@ float WahAudioProcessor::getRmsValue(const int channel) const
     return 0.f;
 }
 
+bool WahAudioProcessor::getSpectrum(int stream, float* bands)
+{
+    return analyser.getBands(stream, bands);
+}
+
+float WahAudioProcessor::getCutoff() const
+{
+    return currentCutoff.load();
+}
+
+const Diagnostics::BlockTimer& WahAudioProcessor::getBlockTimer() const
+{
+    return blockTimer;
+}
+
+void WahAudioProcessor::setAnalyserEnabled(bool shouldBeEnabled)
+{
+    analyser.setEnabled(shouldBeEnabled);
+}
+
 void WahAudioProcessor::set_wet(float val)
 {
     wet = val;
@@ -336,11 +705,13 @@ void WahAudioProcessor::set_dry(float val)
 void WahAudioProcessor::set_depth(float val)
 {
     depth = val;
+    updateSweepTable();
 }
 
 void WahAudioProcessor::set_quality(float val)
 {
     Q = val;
+    vowelTable.request(vowelPath, vowelPathLength, Q);
 }
 
 void WahAudioProcessor::set_decay(float val)
@@ -371,16 +742,116 @@ void WahAudioProcessor::set_filter(int val)
 void WahAudioProcessor::set_rate(float val)
 {
     rate = val;
+    currentRate.store(rate);
+}
+
+float WahAudioProcessor::getRate() const
+{
+    return currentRate.load();
+}
+
+void WahAudioProcessor::tap()
+{
+    editorTapTime.store(juce::Time::getMillisecondCounterHiRes());
+    ++editorTaps;
+}
+
+// Audio thread: time is on the sample clock, no later than this block's end
+void WahAudioProcessor::handleTap(juce::int64 time, juce::int64 blockStart)
+{
+    if (tapTempo.tap(time))
+    {
+        rate = (float) (getSampleRate() / tapTempo.getPeriod());
+        currentRate.store(rate);
+    }
+    
+    // phase at the start of the block such that the cycle restarts on the tap
+    lfo.setRate(rate);
+    lfo.setPhase(-(double) (time - blockStart) * rate / getSampleRate());
 }
 
 void WahAudioProcessor::set_firstVowel(int val)
 {
     firstVowel = val;
+    const int path[] = { firstVowel, secondVowel };
+    set_vowelPath(path, 2);
 }
 
 void WahAudioProcessor::set_secondVowel(int val)
 {
     secondVowel = val;
+    const int path[] = { firstVowel, secondVowel };
+    set_vowelPath(path, 2);
+}
+
+void WahAudioProcessor::set_vowelPath(const int* vowels, int numVowels)
+{
+    vowelPathLength = juce::jlimit(1, Dsp::VowelMorphTable::maxPathLength, numVowels);
+    
+    for (int i = 0; i < vowelPathLength; i++)
+        vowelPath[i] = vowels[i];
+    
+    vowelTable.request(vowelPath, vowelPathLength, Q);
+}
+
+void WahAudioProcessor::set_link(int val)
+{
+    link = val;
+}
+
+void WahAudioProcessor::set_detector(int val)
+{
+    detector = val;
+}
+
+void WahAudioProcessor::set_lookahead(float val)
+{
+    lookahead = juce::jlimit(0.0f, maxLookahead, val);
+    updateLatency();
+}
+
+void WahAudioProcessor::delayAudioPath(juce::AudioBuffer<float>& buffer, int numChannels)
+{
+    for (int channel = 0; channel < numChannels; channel++)
+    {
+        delayLines[channel]->setDelay(lookaheadSamples.load());
+        delayLines[channel]->process(buffer.getWritePointer(channel), buffer.getNumSamples());
+    }
+}
+
+// The audio path follows its own copy rather than what the host was told
+void WahAudioProcessor::updateLatency()
+{
+    const int samples = juce::roundToInt(lookahead * getSampleRate());
+    lookaheadSamples.store(samples);
+    setLatencySamples(samples);
+}
+
+void WahAudioProcessor::set_lfoShape(int val)
+{
+    lfoShape = val;
+}
+
+void WahAudioProcessor::set_userShape(const float* points, int numPoints)
+{
+    jassert(numPoints == Dsp::Lfo::numUserPoints);
+    std::copy(points, points + juce::jmin(numPoints, Dsp::Lfo::numUserPoints), userShape);
+    lfo.setUserShape(points, numPoints);
+}
+
+void WahAudioProcessor::set_mapping(int val)
+{
+    mapping = val;
+    updateSweepTable();
+}
+
+void WahAudioProcessor::updateSweepTable()
+{
+    if (getSampleRate() > 0.0)
+        sweepTable.build(minFreq, minFreq + depth, mapping, getSampleRate());
+    
+    // depth or mapping edited after a program change: back to our own table
+    programSweep.store(nullptr);
 }
 
 void WahAudioProcessor::toggle_humanizer()
@@ -388,6 +859,208 @@ void WahAudioProcessor::toggle_humanizer()
     humanizerOn = !humanizerOn;
 }
 
+void WahAudioProcessor::set_humanizer(bool val)
+{
+    humanizerOn = val;
+}
+
+void WahAudioProcessor::set_band(int val)
+{
+    band = val;
+}
+
+void WahAudioProcessor::set_crossover(float val)
+{
+    crossover = val;
+}
+
+void WahAudioProcessor::set_stereoPhase(float val)
+{
+    stereoPhase = val;
+}
+
+void WahAudioProcessor::set_stereoMode(int val)
+{
+    stereoMode = val;
+}
+
+void WahAudioProcessor::set_tapNote(int val)
+{
+    tapNote = val;
+}
+
+void WahAudioProcessor::set_tapChannel(int val)
+{
+    tapChannel = val;
+}
+
+State::Settings WahAudioProcessor::getSettings() const
+{
+    State::Settings settings;
+    
+    settings.depth = depth;
+    settings.quality = Q;
+    settings.attack = atk;
+    settings.decay = rel;
+    settings.gain = G;
+    settings.mix = wet;
+    settings.rate = rate;
+    settings.lookahead = lookahead;
+    settings.mode = mode;
+    settings.filter = filter;
+    settings.link = link;
+    settings.detector = detector;
+    settings.lfoShape = lfoShape;
+    settings.mapping = mapping;
+    settings.humanizer = humanizerOn;
+    settings.band = band;
+    settings.crossover = crossover;
+    settings.stereoPhase = stereoPhase;
+    settings.stereoMode = stereoMode;
+    settings.tapNote = tapNote;
+    settings.tapChannel = tapChannel;
+    settings.vowelPathLength = vowelPathLength;
+    std::copy(vowelPath, vowelPath + vowelPathLength, settings.vowelPath);
+    std::copy(userShape, userShape + Dsp::Lfo::numUserPoints, settings.userShape);
+    
+    return settings;
+}
+
+void WahAudioProcessor::setSettings(const State::Settings& settings)
+{
+    set_depth(settings.depth);
+    set_attack(settings.attack);
+    set_decay(settings.decay);
+    set_gain(settings.gain);
+    set_wet(settings.mix);
+    set_dry(1.0f - settings.mix);
+    set_rate(settings.rate);
+    set_lookahead(settings.lookahead);
+    set_mode(settings.mode);
+    set_filter(settings.filter);
+    set_link(settings.link);
+    set_detector(settings.detector);
+    set_lfoShape(settings.lfoShape);
+    set_mapping(settings.mapping);
+    set_humanizer(settings.humanizer);
+    set_band(settings.band);
+    set_crossover(settings.crossover);
+    set_stereoPhase(settings.stereoPhase);
+    set_stereoMode(settings.stereoMode);
+    set_tapNote(settings.tapNote);
+    set_tapChannel(settings.tapChannel);
+    set_userShape(settings.userShape, Dsp::Lfo::numUserPoints);
+    
+    // quality and path feed the same vowel table, so request it once
+    Q = settings.quality;
+    firstVowel = settings.vowelPath[0];
+    secondVowel = settings.vowelPath[juce::jmin(1, settings.vowelPathLength - 1)];
+    set_vowelPath(settings.vowelPath, settings.vowelPathLength);
+    
+    crossfadeRequested.store(true);
+    ++settingsGeneration;
+}
+
+// Audio thread (or prepareToPlay): pins the pending snapshot before taking
+// it, so loadSettings can't refill it while it is copied or its sweep read
+void WahAudioProcessor::applyPendingSnapshot()
+{
+    for (;;)
+    {
+        const Snapshot* snapshot = pendingSnapshot.load();
+        
+        if (snapshot == nullptr)
+            return;
+        
+        snapshotInUse.store(snapshot);
+        
+        if (pendingSnapshot.compare_exchange_strong(snapshot, nullptr))
+        {
+            applySnapshot(*snapshot);
+            return;
+        }
+        
+        // replaced or withdrawn meanwhile: the previous pin is gone, and with
+        // it the right to read its sweep
+        programSweep.store(nullptr);
+    }
+}
+
+// Audio thread (or prepareToPlay): plain copies only, the sweep table was
+// prebuilt and the vowel table is requested from its own thread. The lookahead,
+// the drawn LFO shape and the tap note are left alone, snapshots don't change latency
+// or the controller setup.
+void WahAudioProcessor::applySnapshot(const Snapshot& snapshot)
+{
+    const auto& settings = snapshot.settings;
+    
+    depth = settings.depth;
+    atk = settings.attack;
+    rel = settings.decay;
+    G = settings.gain;
+    wet = settings.mix;
+    dry = 1.0f - settings.mix;
+    rate = settings.rate;
+    currentRate.store(rate);
+    mode = settings.mode;
+    filter = settings.filter;
+    link = settings.link;
+    detector = settings.detector;
+    lfoShape = settings.lfoShape;
+    mapping = settings.mapping;
+    humanizerOn = settings.humanizer;
+    band = settings.band;
+    crossover = settings.crossover;
+    stereoPhase = settings.stereoPhase;
+    stereoMode = settings.stereoMode;
+    
+    Q = settings.quality;
+    vowelPathLength = settings.vowelPathLength;
+    std::copy(settings.vowelPath, settings.vowelPath + vowelPathLength, vowelPath);
+    firstVowel = vowelPath[0];
+    secondVowel = vowelPath[juce::jmin(1, vowelPathLength - 1)];
+    vowelTable.request(vowelPath, vowelPathLength, Q);
+    
+    programSweep.store(snapshot.sweep.get());
+    crossfadeRequested.store(true);
+    ++settingsGeneration;
+}
+
+void WahAudioProcessor::loadSettings(const State::Settings& settings)
+{
+    // nothing is playing yet, apply directly
+    if (getSampleRate() <= 0.0)
+    {
+        setSettings(settings);
+        return;
+    }
+    
+    // the parts a snapshot leaves alone
+    set_lookahead(settings.lookahead);
+    set_userShape(settings.userShape, Dsp::Lfo::numUserPoints);
+    set_tapNote(settings.tapNote);
+    set_tapChannel(settings.tapChannel);
+    
+    // a slot neither waiting for the audio thread nor pinned by it; pending
+    // is read first, a snapshot taken after that read is pinned by then
+    const Snapshot* pending = pendingSnapshot.load();
+    const Snapshot* inUse = snapshotInUse.load();
+    auto* slot = presetSnapshots;
+    
+    while (slot == pending || slot == inUse)
+        slot++;
+    
+    auto& snapshot = *slot;
+    snapshot.settings = settings;
+    Dsp::SweepTable::fill(snapshot.sweep.get(), minFreq, minFreq + settings.depth, settings.mapping, getSampleRate());
+    pendingSnapshot.store(&snapshot);
+}
+
+int WahAudioProcessor::getSettingsGeneration() const
+{
+    return settingsGeneration.load();
+}
+
 //==============================================================================
 // This creates new instances of the plugin..
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
@@ -9,6 +9,21 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "DSP/EnvelopeDetector.h"
+#include "DSP/DelayLine.h"
+#include "DSP/Lfo.h"
+#include "DSP/SampleBuffer.h"
+#include "DSP/SweepTable.h"
+#include "DSP/FormantBank.h"
+#include "DSP/VowelMorphTable.h"
+#include "DSP/SpectrumAnalyser.h"
+#include "DSP/TapTempo.h"
+#include "DSP/MidiClock.h"
+#include "DSP/WahEngine.h"
+#include "Diagnostics/BlockTimer.h"
+#include "Diagnostics/Trace.h"
+#include "State/Settings.h"
+#include "State/FactoryPrograms.h"
 
 //==============================================================================
 #define SAMPLE_RATE (44100)
@@ -35,6 +50,8 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlockBypassed (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    juce::AudioProcessorParameter* getBypassParameter() const override;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -60,6 +77,10 @@ public:
     void setStateInformation (const void* data, int sizeInBytes) override;
     
     float getRmsValue(const int channel) const;
+    bool getSpectrum(int stream, float* bands);
+    float getCutoff() const;
+    const Diagnostics::BlockTimer& getBlockTimer() const;
+    void setAnalyserEnabled(bool shouldBeEnabled);
     
     void set_wet(float val);
     void set_dry(float val);
@@ -73,27 +94,155 @@ public:
     void set_rate(float val);
     void set_firstVowel(int val);
     void set_secondVowel(int val);
+    void set_vowelPath(const int* vowels, int numVowels);
+    void set_link(int val);
+    void set_detector(int val);
+    void set_lookahead(float val);
+    void set_lfoShape(int val);
+    void set_mapping(int val);
+    void set_userShape(const float* points, int numPoints);
     void toggle_humanizer();
+    void set_humanizer(bool val);
+    void set_band(int val);
+    void set_crossover(float val);
+    void set_stereoPhase(float val);
+    void set_stereoMode(int val);
+    void set_tapNote(int val);
+    void set_tapChannel(int val);
+    
+    // Message thread: a tap from the editor, timed when it's called
+    void tap();
+    
+    // The sweep rate as last set, by a setting, taps or MIDI clock; those
+    // leave the settings generation alone so they don't resync the whole editor
+    float getRate() const;
+    
+    // Whole-state snapshot; setSettings bumps the generation so an open
+    // editor knows to pull the new values into its controls.
+    State::Settings getSettings() const;
+    void setSettings(const State::Settings& settings);
+    int getSettingsGeneration() const;
+    
+    // Message thread: hands a preset to the audio thread in one piece
+    void loadSettings(const State::Settings& settings);
 
 private:
     
     float minFreq, maxFreq, freq, Q, atk, rel, G, dry, wet, depth, rate;
-    int filter, mode, firstVowel, secondVowel;
+    int filter, mode, firstVowel, secondVowel, link, detector, lfoShape, mapping, band;
+    float crossover, stereoPhase;
+    int stereoMode;
     bool humanizerOn;
+    float userShape[Dsp::Lfo::numUserPoints];
+    std::atomic<int> settingsGeneration { 0 };
+    
+    // Settings snapshots for factory programs and loaded presets: the host, a
+    // MIDI program change or the preset browser posts a pointer to a prebuilt
+    // snapshot, the audio thread takes it at the start of a block. Sweep
+    // tables are built for the current sample rate before posting. The
+    // snapshot the audio thread last took stays pinned while its sweep is in
+    // use, so loading presets quickly never refills that one.
+    struct Snapshot
+    {
+        State::Settings settings;
+        juce::HeapBlock<Dsp::SweepTable::Coefficient> sweep;
+    };
+    
+    int currentProgram = 0;
+    juce::OwnedArray<Snapshot> programSnapshots;
+    Snapshot presetSnapshots[3];
+    std::atomic<const Snapshot*> pendingSnapshot { nullptr };
+    std::atomic<const Snapshot*> snapshotInUse { nullptr };
+    std::atomic<const Dsp::SweepTable::Coefficient*> programSweep { nullptr };
+    void applyPendingSnapshot();
+    void applySnapshot(const Snapshot& snapshot);
+    
+    // Tap tempo: taps from the editor, a note-on of tapNote on tapChannel (0
+    // for any) or the host's tap parameter are timestamped on a running
+    // sample clock; each one restarts the sweep cycle on the tap, and the
+    // averaged interval sets the rate
+    Dsp::TapTempo tapTempo;
+    int tapNote = 36, tapChannel = 1;
+    juce::AudioParameterBool* tapParameter;
+    bool tapParameterDown = false;
+    juce::int64 sampleClock = 0;
+    std::atomic<double> editorTapTime { 0.0 };
+    std::atomic<int> editorTaps { 0 };
+    int editorTapsSeen = 0;
+    std::atomic<float> currentRate { 0.0f };
+    void handleTap(juce::int64 time, juce::int64 blockStart);
+    
+    // Incoming MIDI clock: while it's locked it sets the rate, one sweep
+    // cycle per beat, and while running the phase too
+    Dsp::MidiClock midiClock;
     
-    float formants [5][2] = {{1000.0,1400.0},{500.0,2300.0},{320.0,2500.0},{500.0,1000.0},{320.0,800.0}}; // A E I O U
+    // Sweep position to SVF coefficient
+    Dsp::SweepTable sweepTable;
+    void updateSweepTable();
     
-    // Time in samples
-    juce::Array<int> sample;
+    // Tempo-mode sweep: one oscillator, each channel reading it at its own
+    // phase offset. Offset: the channels after the first lag by stereoPhase.
+    // Spread: the channels are spread evenly over stereoPhase, centred on the
+    // oscillator so the mid signal stays on the beat.
+    Dsp::Lfo lfo;
+    Dsp::SampleBuffer<Dsp::EngineSample> lfoBuffer;
+    juce::HeapBlock<double> lfoOffsets;
     
     // Envelope
-    juce::Array<float> env;
+    juce::OwnedArray<Dsp::EnvelopeDetector> detectors;
+    Dsp::SampleBuffer<Dsp::EngineSample> envBuffer;
     
-    // State variable filter
-    juce::Array<float> yh, yb, yl;
-    juce::Array<float> yh1, yb1, yl1, yh2, yb2, yl2;
+    // Stereo-linked detector, its coefficients are shared by all channels;
+    // the combined level is built in sidechainBuffer
+    Dsp::EnvelopeDetector linkedDetector;
+    juce::AudioBuffer<float> sidechainBuffer;
+    
+    // Lookahead on the audio path, so the detector sees transients early;
+    // changes crossfade in the delay lines
+    static constexpr float maxLookahead = 0.01f;
+    float lookahead = 0.0f;
+    std::atomic<int> lookaheadSamples { 0 };
+    juce::OwnedArray<Dsp::DelayLine> delayLines;
+    void updateLatency();
+    void delayAudioPath(juce::AudioBuffer<float>& buffer, int numChannels);
+    
+    // Host bypass: fades to the latency-aligned dry signal, then runs nothing
+    // but the lookahead delay; the DSP restarts from reset state on the way back
+    static constexpr float bypassFadeTime = 0.02f;
+    juce::AudioParameterBool* bypass;
+    juce::LinearSmoothedValue<float> processedGain { 1.0f };
+    juce::AudioBuffer<float> bypassBuffer; // delayed dry channels, then the gain ramp
+    bool fullyBypassed = false;
+    
+    // Sleep on silence: once the input has been silent for longer than the
+    // lookahead and the filter has rung out, nothing runs and the output is zeros
+    static constexpr float silenceThreshold = 1.0e-5f; // -100 dB
+    juce::int64 silentSamples = 0;
+    bool sleeping = false;
+    
+    // Filter section: one engine runs, the other only while crossfading from
+    // the old filter state after a mode, filter or humanizer switch or a
+    // program change
+    static constexpr float crossfadeTime = 0.02f;
+    Dsp::WahEngine engines[2];
+    int activeEngine = 0;
+    int crossfadeLength = 0, crossfadeRemaining = 0;
+    juce::AudioBuffer<float> crossfadeBuffer;
+    std::atomic<bool> crossfadeRequested { false };
+    
+    // Humanizer vowel morph coefficients
+    Dsp::VowelMorphTable vowelTable;
+    int vowelPath[Dsp::VowelMorphTable::maxPathLength];
+    int vowelPathLength;
     
     juce::LinearSmoothedValue<float> rmsLevelLeft, rmsLevelRight;
+    
+    // Input/output spectra and instantaneous cutoff for the editor
+    Dsp::SpectrumAnalyser analyser;
+    std::atomic<float> currentCutoff { 0.0f };
+    
+    // Audio-thread CPU load
+    Diagnostics::BlockTimer blockTimer;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WahAudioProcessor)
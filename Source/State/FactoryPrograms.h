@@ -0,0 +1,173 @@
+/*
+  ==============================================================================
+
+    FactoryPrograms.h
+    Created: 19 Oct 2026 9:33:00am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Settings.h"
+
+namespace State
+{
+    struct Program
+    {
+        const char* name;
+        Settings settings;
+    };
+
+    // The factory bank, built once and never changed, so a pointer to one of
+    // its programs stays valid for the lifetime of the plugin.
+    class FactoryPrograms
+    {
+    public:
+        static int getNumPrograms()
+        {
+            return (int) getPrograms().size();
+        }
+
+        static const Program& getProgram(int index)
+        {
+            return getPrograms()[(size_t) juce::jlimit(0, getNumPrograms() - 1, index)];
+        }
+
+    private:
+        static const std::vector<Program>& getPrograms()
+        {
+            static const std::vector<Program> programs = build();
+            return programs;
+        }
+
+        static Settings withVowels(Settings s, std::initializer_list<int> path)
+        {
+            s.vowelPathLength = 0;
+
+            for (auto v : path)
+                s.vowelPath[s.vowelPathLength++] = v;
+
+            return s;
+        }
+
+        static std::vector<Program> build()
+        {
+            std::vector<Program> programs;
+
+            programs.push_back({ "Init", Settings() });
+
+            {
+                Settings s;
+                s.mode = 1;
+                s.filter = 1;
+                s.depth = 1300.0f;
+                s.quality = 0.12f;
+                s.attack = 0.005f;
+                s.decay = 0.15f;
+                s.mix = 1.0f;
+                s.mapping = Dsp::SweepTable::exponential;
+                programs.push_back({ "Classic Cry Baby", s });
+            }
+
+            {
+                Settings s;
+                s.mode = 1;
+                s.filter = 0;
+                s.depth = 2500.0f;
+                s.quality = 0.08f;
+                s.attack = 0.002f;
+                s.decay = 0.08f;
+                s.mix = 0.8f;
+                s.detector = Dsp::EnvelopeDetector::rms;
+                s.mapping = Dsp::SweepTable::exponential;
+                programs.push_back({ "Funk Auto-Wah", s });
+            }
+
+            {
+                Settings s;
+                s.mode = 1;
+                s.filter = 1;
+                s.depth = 4000.0f;
+                s.quality = 0.12f;
+                s.attack = 0.001f;
+                s.decay = 0.2f;
+                s.mix = 0.9f;
+                s.link = 1;
+                s.detector = Dsp::EnvelopeDetector::logarithmic;
+                s.mapping = Dsp::SweepTable::exponential;
+                programs.push_back({ "Stereo Envelope", s });
+            }
+
+            {
+                Settings s = withVowels(Settings(), { 4, 0, 3 });
+                s.mode = 1;
+                s.filter = 1;
+                s.quality = 0.3f;
+                s.attack = 0.004f;
+                s.decay = 0.12f;
+                s.mix = 1.0f;
+                s.humanizer = true;
+                programs.push_back({ "Talk Box", s });
+            }
+
+            {
+                Settings s = withVowels(Settings(), { 0, 1, 2, 3, 4 });
+                s.mode = 0;
+                s.filter = 1;
+                s.quality = 0.3f;
+                s.rate = 4.0f;
+                s.mix = 1.0f;
+                s.lfoShape = Dsp::Lfo::sampleAndHold;
+                s.humanizer = true;
+                programs.push_back({ "Random Vowels", s });
+            }
+
+            {
+                Settings s;
+                s.mode = 0;
+                s.filter = 1;
+                s.depth = 1700.0f;
+                s.quality = 0.1f;
+                s.rate = 2.0f;
+                s.mix = 0.8f;
+                s.lfoShape = Dsp::Lfo::triangle;
+                programs.push_back({ "Tempo Wah", s });
+            }
+
+            {
+                Settings s;
+                s.mode = 0;
+                s.filter = 1;
+                s.depth = 3000.0f;
+                s.quality = 0.3f;
+                s.rate = 0.25f;
+                s.mix = 0.5f;
+                s.lfoShape = Dsp::Lfo::sine;
+                s.mapping = Dsp::SweepTable::exponential;
+                programs.push_back({ "Slow Phaser Sweep", s });
+            }
+
+            {
+                Settings s;
+                s.mode = 1;
+                s.filter = 1;
+                s.depth = 1500.0f;
+                s.quality = 0.15f;
+                s.attack = 0.003f;
+                s.decay = 0.12f;
+                s.mix = 1.0f;
+                s.mapping = Dsp::SweepTable::exponential;
+                s.band = Dsp::WahEngine::highBand;
+                s.crossover = 200.0f;
+                programs.push_back({ "Bass Wah", s });
+            }
+
+            for (auto& program : programs)
+                program.settings.sanitise();
+
+            return programs;
+        }
+    };
+}
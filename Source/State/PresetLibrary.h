@@ -0,0 +1,256 @@
+/*
+  ==============================================================================
+
+    PresetLibrary.h
+    Created: 19 Oct 2026 9:34:28am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Settings.h"
+
+namespace State
+{
+    // User presets in one file: a 16 byte header followed by fixed-size
+    // records, so preset n lives at a known offset. The file is memory-mapped
+    // read-only; browsing and searching only touch the name and tag fields,
+    // a preset's settings are decoded when it is loaded.
+    //
+    //   header  magic 'WAHL', version, record size, number of records (int32 LE)
+    //   record  name (UTF-8, NUL padded), tags (same), settings block size, settings block
+    class PresetLibrary
+    {
+    public:
+        static constexpr int magic = 0x4c484157; // "WAHL"
+        static constexpr int version = 1;
+        static constexpr int headerSize = 16;
+        static constexpr int nameSize = 64;
+        static constexpr int tagsSize = 64;
+        static constexpr int dataSize = 252;
+        static constexpr int recordSize = nameSize + tagsSize + 4 + dataSize;
+
+        explicit PresetLibrary(const juce::File& libraryFile)
+            : file(libraryFile),
+              fileLock("WahPresetLibrary_" + juce::String::toHexString(libraryFile.getFullPathName().hashCode64()))
+        {
+            open();
+        }
+
+        static juce::File getDefaultFile()
+        {
+            return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+                       .getChildFile(JucePlugin_Manufacturer).getChildFile(JucePlugin_Name).getChildFile("Presets.wahlib");
+        }
+
+        int getNumPresets() const
+        {
+            return numRecords;
+        }
+
+        juce::String getName(int index) const
+        {
+            return readField(index, 0, nameSize);
+        }
+
+        juce::String getTags(int index) const
+        {
+            return readField(index, nameSize, tagsSize);
+        }
+
+        // Indices of the presets whose name or tags contain every word of the
+        // query, ignoring case; an empty query matches everything.
+        juce::Array<int> search(const juce::String& query, int maxResults) const
+        {
+            juce::StringArray words;
+            words.addTokens(query, true);
+            words.removeEmptyStrings();
+
+            juce::Array<int> results;
+
+            for (int i = 0; i < numRecords && results.size() < maxResults; i++)
+            {
+                const auto text = getName(i) + " " + getTags(i);
+                bool matches = true;
+
+                for (const auto& word : words)
+                    matches = matches && text.containsIgnoreCase(word);
+
+                if (matches)
+                    results.add(i);
+            }
+
+            return results;
+        }
+
+        bool load(int index, Settings& dest) const
+        {
+            const char* record = getRecord(index);
+
+            if (record == nullptr)
+                return false;
+
+            const int size = (int) juce::ByteOrder::littleEndianInt(record + nameSize + tagsSize);
+
+            return juce::isPositiveAndNotGreaterThan(size, dataSize)
+                && Format::read(record + nameSize + tagsSize + 4, size, dest);
+        }
+
+        // Appends a preset and remaps the file. Other instances (and other
+        // hosts) append to the same file, so the count is read back from disk
+        // and written under an inter-process lock.
+        bool add(const juce::String& name, const juce::String& tags, const Settings& settings)
+        {
+            juce::MemoryBlock data;
+            Format::write(settings, data);
+
+            if ((int) data.getSize() > dataSize)
+            {
+                jassertfalse; // grow dataSize and bump the version
+                return false;
+            }
+
+            char record[recordSize] = {};
+            name.copyToUTF8(record, nameSize);
+            tags.copyToUTF8(record + nameSize, tagsSize);
+            writeInt(record + nameSize + tagsSize, (int) data.getSize());
+            memcpy(record + nameSize + tagsSize + 4, data.getData(), data.getSize());
+
+            const juce::InterProcessLock::ScopedLockType scopedLock(fileLock);
+
+            if (!scopedLock.isLocked())
+                return false;
+
+            // the mapping has to go before the file can be written on some systems
+            mappedFile.reset();
+
+            const bool ok = append(record);
+            open();
+            return ok;
+        }
+
+    private:
+        juce::File file;
+        juce::InterProcessLock fileLock;
+        std::unique_ptr<juce::MemoryMappedFile> mappedFile;
+        int numRecords = 0;
+
+        void open()
+        {
+            numRecords = 0;
+            mappedFile.reset();
+
+            if (!file.existsAsFile())
+                return;
+
+            mappedFile = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+            const auto* data = static_cast<const char*>(mappedFile->getData());
+            const auto size = (juce::int64) mappedFile->getSize();
+
+            if (data == nullptr || size < headerSize
+                || (int) juce::ByteOrder::littleEndianInt(data) != magic
+                || (int) juce::ByteOrder::littleEndianInt(data + 8) != recordSize)
+            {
+                mappedFile.reset();
+                return;
+            }
+
+            numRecords = getValidCount(data, size);
+        }
+
+        // a record cut short by a crash while appending is ignored
+        static int getValidCount(const char* header, juce::int64 size)
+        {
+            const int count = (int) juce::ByteOrder::littleEndianInt(header + 12);
+            return (int) juce::jlimit((juce::int64) 0, (size - headerSize) / recordSize, (juce::int64) count);
+        }
+
+        // The count on disk now, which another instance may have moved on
+        // since the file was mapped; false if the file isn't a library
+        bool readCount(int& count) const
+        {
+            juce::FileInputStream in(file);
+            char header[headerSize];
+
+            if (in.failedToOpen() || in.read(header, headerSize) != headerSize
+                || (int) juce::ByteOrder::littleEndianInt(header) != magic
+                || (int) juce::ByteOrder::littleEndianInt(header + 8) != recordSize)
+                return false;
+
+            count = getValidCount(header, in.getTotalLength());
+            return true;
+        }
+
+        const char* getRecord(int index) const
+        {
+            if (mappedFile == nullptr || !juce::isPositiveAndBelow(index, numRecords))
+                return nullptr;
+
+            return static_cast<const char*>(mappedFile->getData()) + headerSize + (size_t) index * recordSize;
+        }
+
+        juce::String readField(int index, int offset, int size) const
+        {
+            const char* record = getRecord(index);
+
+            if (record == nullptr)
+                return {};
+
+            const char* field = record + offset;
+            return juce::String::fromUTF8(field, (int) strnlen(field, (size_t) size));
+        }
+
+        static void writeInt(char* dest, int value)
+        {
+            const auto le = juce::ByteOrder::swapIfBigEndian((juce::uint32) value);
+            memcpy(dest, &le, 4);
+        }
+
+        bool append(const char* record)
+        {
+            const bool isNew = !file.existsAsFile() || file.getSize() == 0;
+            int count = 0;
+
+            // never write into a file that isn't a library
+            if (!isNew && !readCount(count))
+                return false;
+
+            if (isNew && !file.create().wasOk())
+                return false;
+
+            juce::FileOutputStream out(file);
+
+            if (out.failedToOpen())
+                return false;
+
+            if (isNew)
+            {
+                char header[headerSize];
+                writeInt(header, magic);
+                writeInt(header + 4, version);
+                writeInt(header + 8, recordSize);
+                writeInt(header + 12, 0);
+
+                out.setPosition(0);
+                out.truncate();
+                out.write(header, headerSize);
+            }
+
+            // records go straight after the last valid one, the count last
+            out.setPosition(headerSize + (juce::int64) count * recordSize);
+            out.write(record, recordSize);
+
+            char countBytes[4];
+            writeInt(countBytes, count + 1);
+            out.setPosition(12);
+            out.write(countBytes, 4);
+            out.flush();
+
+            return out.getStatus().wasOk();
+        }
+
+        JUCE_DECLARE_NON_COPYABLE(PresetLibrary)
+    };
+}
@@ -0,0 +1,255 @@
+/*
+  ==============================================================================
+
+    Settings.h
+    Created: 19 Oct 2026 9:31:26am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../DSP/EnvelopeDetector.h"
+#include "../DSP/Lfo.h"
+#include "../DSP/SweepTable.h"
+#include "../DSP/VowelMorphTable.h"
+#include "../DSP/WahEngine.h"
+
+namespace State
+{
+    // Every user-facing setting of the processor as plain data, with the
+    // defaults the plugin starts with.
+    struct Settings
+    {
+        float depth = 1700.0f;
+        float quality = 0.1f;
+        float attack = 0.002f;
+        float decay = 0.1f;
+        float gain = 1.0f;
+        float mix = 0.5f;
+        float rate = 1.0f;      // tempo mode sweep rate in Hz, set by tap tempo
+        float lookahead = 0.0f; // seconds
+
+        int mode = 0;           // 0 tempo, 1 dynamic
+        int filter = 0;         // 0 low pass, 1 band pass, 2 high pass
+        int link = 0;           // 0 off, 1 max, 2 mean of the channels
+        int detector = Dsp::EnvelopeDetector::peak;
+        int lfoShape = Dsp::Lfo::sine;
+        int mapping = Dsp::SweepTable::linear;
+        bool humanizer = false;
+        int band = Dsp::WahEngine::fullBand;
+        float crossover = 250.0f; // Hz, between the wahed and the dry band
+        float stereoPhase = 0.0f; // degrees between the channels' tempo sweeps
+        int stereoMode = 0;       // 0 offset, 1 spread
+        int tapNote = 36;         // the MIDI note that taps the tempo
+        int tapChannel = 1;       // 1..16, 0 listens on every channel
+
+        int vowelPath[Dsp::VowelMorphTable::maxPathLength] = {};
+        int vowelPathLength = 2;
+
+        float userShape[Dsp::Lfo::numUserPoints];
+
+        Settings()
+        {
+            for (int i = 0; i < Dsp::Lfo::numUserPoints; i++)
+                userShape[i] = std::sin(juce::MathConstants<float>::twoPi * i / Dsp::Lfo::numUserPoints);
+        }
+
+        // Clamps everything into the ranges the processor accepts; a value
+        // that isn't finite (a corrupt state) gets its default first, since
+        // jlimit lets NaN through
+        void sanitise()
+        {
+            const Settings defaults;
+
+            auto makeFinite = [](float& value, float fallback)
+            {
+                if (!std::isfinite(value))
+                    value = fallback;
+            };
+
+            makeFinite(depth, defaults.depth);
+            makeFinite(quality, defaults.quality);
+            makeFinite(attack, defaults.attack);
+            makeFinite(decay, defaults.decay);
+            makeFinite(gain, defaults.gain);
+            makeFinite(mix, defaults.mix);
+            makeFinite(rate, defaults.rate);
+            makeFinite(lookahead, defaults.lookahead);
+            makeFinite(crossover, defaults.crossover);
+            makeFinite(stereoPhase, defaults.stereoPhase);
+
+            for (int i = 0; i < Dsp::Lfo::numUserPoints; i++)
+                makeFinite(userShape[i], defaults.userShape[i]);
+
+            depth = juce::jlimit(0.0f, 10000.0f, depth);
+            quality = juce::jlimit(0.01f, 1.0f, quality);
+            attack = juce::jlimit(0.001f, 0.1f, attack);
+            decay = juce::jlimit(0.01f, 2.0f, decay);
+            gain = juce::jlimit(0.0f, 5.0f, gain);
+            mix = juce::jlimit(0.0f, 1.0f, mix);
+            rate = juce::jlimit(0.01f, 50.0f, rate);
+            lookahead = juce::jlimit(0.0f, 0.01f, lookahead);
+
+            mode = juce::jlimit(0, 1, mode);
+            filter = juce::jlimit(0, 2, filter);
+            link = juce::jlimit(0, 2, link);
+            detector = juce::jlimit(0, (int) Dsp::EnvelopeDetector::logarithmic, detector);
+            lfoShape = juce::jlimit(0, Dsp::Lfo::numShapes - 1, lfoShape);
+            mapping = juce::jlimit(0, (int) Dsp::SweepTable::exponential, mapping);
+            band = juce::jlimit(0, (int) Dsp::WahEngine::lowBand, band);
+            crossover = juce::jlimit(40.0f, 2000.0f, crossover);
+            stereoPhase = juce::jlimit(0.0f, 180.0f, stereoPhase);
+            stereoMode = juce::jlimit(0, 1, stereoMode);
+            tapNote = juce::jlimit(0, 127, tapNote);
+            tapChannel = juce::jlimit(0, 16, tapChannel);
+
+            vowelPathLength = juce::jlimit(1, Dsp::VowelMorphTable::maxPathLength, vowelPathLength);
+
+            for (auto& v : vowelPath)
+                v = juce::jlimit(0, Dsp::FormantBank::numVowels - 1, v);
+
+            for (auto& p : userShape)
+                p = juce::jlimit(-1.0f, 1.0f, p);
+        }
+    };
+
+    // Compact little-endian binary encoding of Settings:
+    //
+    //   magic 'WAHS', version, payload size in bytes, payload
+    //
+    // Each version only appends fields to the previous one's payload, so an
+    // older state is read up to where it ends (the rest keeps its defaults) and
+    // a newer one is read up to what this version knows (the rest is skipped).
+    namespace Format
+    {
+        static constexpr int magic = 0x53484157; // "WAHS"
+        static constexpr int currentVersion = 4;
+
+        inline void write(const Settings& s, juce::MemoryBlock& dest)
+        {
+            juce::MemoryOutputStream payload(256);
+
+            // version 1
+            payload.writeFloat(s.depth);
+            payload.writeFloat(s.quality);
+            payload.writeFloat(s.attack);
+            payload.writeFloat(s.decay);
+            payload.writeFloat(s.gain);
+            payload.writeFloat(s.mix);
+            payload.writeFloat(s.rate);
+            payload.writeFloat(s.lookahead);
+            payload.writeByte((char) s.mode);
+            payload.writeByte((char) s.filter);
+            payload.writeByte((char) s.link);
+            payload.writeByte((char) s.detector);
+            payload.writeByte((char) s.lfoShape);
+            payload.writeByte((char) s.mapping);
+            payload.writeBool(s.humanizer);
+            payload.writeByte((char) s.vowelPathLength);
+
+            for (int i = 0; i < s.vowelPathLength; i++)
+                payload.writeByte((char) s.vowelPath[i]);
+
+            for (auto p : s.userShape)
+                payload.writeFloat(p);
+
+            // version 2
+            payload.writeByte((char) s.band);
+            payload.writeFloat(s.crossover);
+
+            // version 3
+            payload.writeFloat(s.stereoPhase);
+            payload.writeByte((char) s.stereoMode);
+
+            // version 4
+            payload.writeByte((char) s.tapNote);
+            payload.writeByte((char) s.tapChannel);
+
+            juce::MemoryOutputStream out(dest, false);
+            out.writeInt(magic);
+            out.writeInt(currentVersion);
+            out.writeInt((int) payload.getDataSize());
+            out.write(payload.getData(), payload.getDataSize());
+        }
+
+        // Returns false, leaving dest untouched, if data isn't a settings block
+        inline bool read(const void* data, int sizeInBytes, Settings& dest)
+        {
+            if (data == nullptr || sizeInBytes < 12)
+                return false;
+
+            juce::MemoryInputStream in(data, (size_t) sizeInBytes, false);
+
+            if (in.readInt() != magic)
+                return false;
+
+            const int version = in.readInt();
+            const int payloadSize = in.readInt();
+
+            if (version < 1 || payloadSize < 0 || payloadSize > in.getNumBytesRemaining())
+                return false;
+
+            juce::MemoryInputStream payload(static_cast<const char*>(data) + 12, (size_t) payloadSize, false);
+            Settings s;
+
+            // version 1: 8 floats, 8 bytes, the path, the user shape
+            if (payloadSize < 8 * 4 + 8)
+                return false;
+
+            s.depth = payload.readFloat();
+            s.quality = payload.readFloat();
+            s.attack = payload.readFloat();
+            s.decay = payload.readFloat();
+            s.gain = payload.readFloat();
+            s.mix = payload.readFloat();
+            s.rate = payload.readFloat();
+            s.lookahead = payload.readFloat();
+            s.mode = payload.readByte();
+            s.filter = payload.readByte();
+            s.link = payload.readByte();
+            s.detector = payload.readByte();
+            s.lfoShape = payload.readByte();
+            s.mapping = payload.readByte();
+            s.humanizer = payload.readBool();
+            s.vowelPathLength = juce::jlimit(1, Dsp::VowelMorphTable::maxPathLength, (int) payload.readByte());
+
+            if (payload.getNumBytesRemaining() < s.vowelPathLength + Dsp::Lfo::numUserPoints * 4)
+                return false;
+
+            for (int i = 0; i < s.vowelPathLength; i++)
+                s.vowelPath[i] = payload.readByte();
+
+            for (auto& p : s.userShape)
+                p = payload.readFloat();
+
+            // version 2: band split
+            if (version >= 2 && payload.getNumBytesRemaining() >= 1 + 4)
+            {
+                s.band = payload.readByte();
+                s.crossover = payload.readFloat();
+            }
+
+            // version 3: stereo sweep
+            if (version >= 3 && payload.getNumBytesRemaining() >= 4 + 1)
+            {
+                s.stereoPhase = payload.readFloat();
+                s.stereoMode = payload.readByte();
+            }
+
+            // version 4: tap tempo note
+            if (version >= 4 && payload.getNumBytesRemaining() >= 1 + 1)
+            {
+                s.tapNote = payload.readByte();
+                s.tapChannel = payload.readByte();
+            }
+
+            // later versions continue here, guarded by version checks
+
+            s.sanitise();
+            dest = s;
+            return true;
+        }
+    }
+}
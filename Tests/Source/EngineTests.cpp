@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+    EngineTests.cpp
+    Created: 19 Oct 2026 10:02:31am
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/DSP/EnvelopeDetector.h"
+#include "../../Source/DSP/Lfo.h"
+#include "../../Source/DSP/WahEngine.h"
+
+// Runs the float and the Q31 builds of the sweep sources and the engine on
+// the same input; the float one is the reference for the fixed point SNR.
+class EngineTests : public juce::UnitTest
+{
+public:
+    EngineTests() : juce::UnitTest("Engine", "Wah") {}
+
+    void runTest() override
+    {
+        const juce::String filterNames[] = { "lowpass", "bandpass", "highpass" };
+
+        for (int filter = 0; filter < 3; filter++)
+        {
+            beginTest("Q31 tempo sweep, " + filterNames[filter]);
+            expectSnr(0, filter, Dsp::SweepTable::linear);
+
+            beginTest("Q31 dynamic sweep, " + filterNames[filter]);
+            expectSnr(1, filter, Dsp::SweepTable::exponential);
+        }
+
+        // the band enters fixed point inside the filter loop
+        beginTest("Q31 tempo sweep, high band only");
+        expectSnr(0, 1, Dsp::SweepTable::linear, Dsp::WahEngine::highBand);
+    }
+
+private:
+    static constexpr double sampleRate = 44100.0;
+    static constexpr int blockSize = 256;
+    static constexpr int numBlocks = 172; // about a second
+    static constexpr double minSnr = 80.0; // dB
+
+    // LFO or envelope into the engine, as the processor wires them
+    template <typename SampleType>
+    struct Chain
+    {
+        Dsp::BasicLfo<SampleType> lfo;
+        Dsp::BasicEnvelopeDetector<SampleType> detector;
+        Dsp::BasicWahEngine<SampleType> engine;
+        juce::HeapBlock<typename Dsp::BasicSweepTable<SampleType>::Coefficient> sweep;
+        juce::HeapBlock<SampleType> positions;
+
+        void prepare(int mode, int filter, int mapping, int band)
+        {
+            lfo.prepare(sampleRate);
+            lfo.setRate(2.0f);
+
+            detector.prepare(sampleRate);
+            detector.setAttackRelease(0.005f, 0.1f);
+
+            engine.prepare(sampleRate, 1, blockSize);
+            engine.parameters.mode = mode;
+            engine.parameters.filter = filter;
+            engine.parameters.band = band;
+            engine.parameters.Q = 0.2f;
+            engine.parameters.wet = 1.0f;
+            engine.parameters.dry = 0.0f;
+
+            sweep.allocate(Dsp::BasicSweepTable<SampleType>::tableSize + 1, true);
+            Dsp::BasicSweepTable<SampleType>::fill(sweep.get(), 350.0f, 2500.0f, mapping, sampleRate);
+
+            positions.allocate(blockSize, true);
+        }
+
+        void process(const float* in, float* out)
+        {
+            if (engine.parameters.mode == 0)
+                lfo.process(positions.get(), blockSize);
+            else
+                detector.process(in, positions.get(), blockSize);
+
+            engine.process(0, in, out, blockSize, positions.get(), sweep.get(), { nullptr, 0 }, false);
+        }
+    };
+
+    void expectSnr(int mode, int filter, int mapping, int band = Dsp::WahEngine::fullBand)
+    {
+        Chain<float> reference;
+        Chain<Dsp::Fixed::Q31> fixed;
+        reference.prepare(mode, filter, mapping, band);
+        fixed.prepare(mode, filter, mapping, band);
+
+        juce::Random random(0x3a1f);
+        float in[blockSize], expected[blockSize], actual[blockSize];
+        double signal = 0.0, noise = 0.0;
+        int n = 0;
+
+        for (int block = 0; block < numBlocks; block++)
+        {
+            // a saw-like chord with a little noise, swelling for the envelope
+            for (int i = 0; i < blockSize; i++, n++)
+            {
+                const double t = n / sampleRate;
+                const double swell = 0.5 + 0.5 * std::sin(juce::MathConstants<double>::twoPi * 3.0 * t);
+                double x = 0.0;
+
+                for (int h = 1; h <= 8; h++)
+                    x += (std::sin(juce::MathConstants<double>::twoPi * 110.0 * h * t)
+                          + std::sin(juce::MathConstants<double>::twoPi * 164.8 * h * t)) / h;
+
+                in[i] = (float) (0.1 * swell * x) + 0.01f * (random.nextFloat() - 0.5f);
+            }
+
+            reference.process(in, expected);
+            fixed.process(in, actual);
+
+            for (int i = 0; i < blockSize; i++)
+            {
+                signal += (double) expected[i] * expected[i];
+                noise += ((double) actual[i] - expected[i]) * ((double) actual[i] - expected[i]);
+            }
+        }
+
+        const double snr = 10.0 * std::log10(signal / juce::jmax(noise, 1.0e-30));
+        logMessage("SNR " + juce::String(snr, 1) + " dB");
+        expect(snr > minSnr, "SNR " + juce::String(snr, 1) + " dB is below " + juce::String(minSnr) + " dB");
+    }
+};
+
+static EngineTests engineTests;
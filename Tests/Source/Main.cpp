@@ -0,0 +1,30 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026 9:54:34am
+
+    Runs every test in the "Wah" category; the exit code is non-zero if
+    any of them failed.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+int main(int argc, char* argv[])
+{
+    juce::ignoreUnused(argc, argv);
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+    runner.runTestsInCategory("Wah");
+
+    for (int i = 0; i < runner.getNumResults(); i++)
+    {
+        if (runner.getResult(i)->failures > 0)
+            return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    SettingsTests.cpp
+    Created: 19 Oct 2026 9:54:34am
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/State/Settings.h"
+
+class SettingsTests : public juce::UnitTest
+{
+public:
+    SettingsTests() : juce::UnitTest("Settings", "Wah") {}
+
+    void runTest() override
+    {
+        beginTest("Round trip");
+        {
+            State::Settings s;
+            s.depth = 2500.0f;
+            s.quality = 0.3f;
+            s.mode = 1;
+            s.band = Dsp::WahEngine::lowBand;
+            s.crossover = 180.0f;
+            s.stereoPhase = 90.0f;
+            s.tapNote = 64;
+            s.tapChannel = 10;
+            s.vowelPathLength = 3;
+            s.vowelPath[2] = 4;
+            s.userShape[5] = -0.5f;
+
+            State::Settings loaded;
+            expect(roundTrip(s, loaded));
+            expectEquals(loaded.depth, s.depth);
+            expectEquals(loaded.quality, s.quality);
+            expectEquals(loaded.mode, s.mode);
+            expectEquals(loaded.band, s.band);
+            expectEquals(loaded.crossover, s.crossover);
+            expectEquals(loaded.stereoPhase, s.stereoPhase);
+            expectEquals(loaded.tapNote, s.tapNote);
+            expectEquals(loaded.tapChannel, s.tapChannel);
+            expectEquals(loaded.vowelPathLength, s.vowelPathLength);
+            expectEquals(loaded.vowelPath[2], s.vowelPath[2]);
+            expectEquals(loaded.userShape[5], s.userShape[5]);
+        }
+
+        beginTest("Non-finite values fall back to their defaults");
+        {
+            const float nan = std::numeric_limits<float>::quiet_NaN();
+            const float inf = std::numeric_limits<float>::infinity();
+            const State::Settings defaults;
+
+            State::Settings s;
+            s.depth = nan;
+            s.quality = nan;
+            s.rate = -inf;
+            s.mix = inf;
+            s.crossover = nan;
+            s.stereoPhase = nan;
+            s.userShape[7] = nan;
+
+            State::Settings loaded;
+            expect(roundTrip(s, loaded));
+            expectEquals(loaded.depth, defaults.depth);
+            expectEquals(loaded.quality, defaults.quality);
+            expectEquals(loaded.rate, defaults.rate);
+            expectEquals(loaded.mix, defaults.mix);
+            expectEquals(loaded.crossover, defaults.crossover);
+            expectEquals(loaded.stereoPhase, defaults.stereoPhase);
+            expectEquals(loaded.userShape[7], defaults.userShape[7]);
+
+            for (auto p : loaded.userShape)
+                expect(std::isfinite(p));
+        }
+
+        beginTest("Older versions keep the defaults of later fields");
+        {
+            State::Settings s;
+            s.band = Dsp::WahEngine::highBand;
+            s.stereoPhase = 45.0f;
+            s.tapNote = 64;
+
+            juce::MemoryBlock block;
+            State::Format::write(s, block);
+
+            // the same payload labelled version 1
+            const auto version1 = juce::ByteOrder::swapIfBigEndian((juce::uint32) 1);
+            block.copyFrom(&version1, 4, 4);
+
+            State::Settings loaded;
+            expect(State::Format::read(block.getData(), (int) block.getSize(), loaded));
+            expectEquals(loaded.band, (int) Dsp::WahEngine::fullBand);
+            expectEquals(loaded.stereoPhase, 0.0f);
+            expectEquals(loaded.tapNote, State::Settings().tapNote);
+        }
+
+        beginTest("Rejects what isn't a settings block");
+        {
+            State::Settings loaded;
+            const char garbage[] = "definitely not a wah state";
+
+            expect(!State::Format::read(garbage, (int) sizeof(garbage), loaded));
+            expect(!State::Format::read(nullptr, 0, loaded));
+
+            juce::MemoryBlock block;
+            State::Format::write(State::Settings(), block);
+            expect(!State::Format::read(block.getData(), 20, loaded));
+        }
+    }
+
+private:
+    static bool roundTrip(const State::Settings& s, State::Settings& dest)
+    {
+        juce::MemoryBlock block;
+        State::Format::write(s, block);
+        return State::Format::read(block.getData(), (int) block.getSize(), dest);
+    }
+};
+
+static SettingsTests settingsTests;
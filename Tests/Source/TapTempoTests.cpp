@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    TapTempoTests.cpp
+    Created: 19 Oct 2026 10:10:02am
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/DSP/TapTempo.h"
+
+class TapTempoTests : public juce::UnitTest
+{
+public:
+    TapTempoTests() : juce::UnitTest("Tap tempo", "Wah") {}
+
+    void runTest() override
+    {
+        beginTest("Steady taps");
+        {
+            Dsp::TapTempo tempo;
+            tempo.prepare(sampleRate);
+
+            for (int i = 0; i < 5; i++)
+                tempo.tap(i * beat);
+
+            expectWithinAbsoluteError(tempo.getPeriod(), (double) beat, 0.5);
+        }
+
+        beginTest("A stray tap between beats is dropped");
+        {
+            Dsp::TapTempo tempo;
+            tempo.prepare(sampleRate);
+
+            for (int i = 0; i < 4; i++)
+                tempo.tap(i * beat);
+
+            expect(! tempo.tap(3 * beat + beat / 2));
+            expect(tempo.tap(4 * beat));
+            expectWithinAbsoluteError(tempo.getPeriod(), (double) beat, 0.5);
+
+            expect(tempo.tap(5 * beat));
+            expectWithinAbsoluteError(tempo.getPeriod(), (double) beat, 0.5);
+        }
+
+        beginTest("Two agreeing intervals change the tempo");
+        {
+            Dsp::TapTempo tempo;
+            tempo.prepare(sampleRate);
+
+            for (int i = 0; i < 4; i++)
+                tempo.tap(i * beat);
+
+            const juce::int64 newBeat = beat * 2 / 3;
+            const juce::int64 start = 3 * beat;
+
+            expect(! tempo.tap(start + newBeat));
+            expect(tempo.tap(start + 2 * newBeat));
+            expectWithinAbsoluteError(tempo.getPeriod(), (double) newBeat, 0.5);
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr juce::int64 beat = 24000; // 120 bpm
+};
+
+static TapTempoTests tapTempoTests;